@@ -3,6 +3,15 @@
 #include <climits>
 #include <array>
 #include <utility>
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <functional>
 
 namespace linal // structures declarations
 {
@@ -11,6 +20,9 @@ namespace linal // structures declarations
     constexpr long double sqrt_05 = 0.707106781186547524401L;
     constexpr long double phi =    0.6180339887498948482046L;
 
+    // alignment of batch buffers, one cache line covers the widest vector registers
+    constexpr std::size_t simd_alignment = 64;
+
     template<typename T>
     struct Vector2;
 
@@ -41,13 +53,13 @@ namespace linal // structures declarations
     struct Quaternion;
 
     template<typename T>
-    struct Rotator3; // to do
+    struct Rotator3;
 
     template<typename T>
-    struct Matrix3x3; // to do
+    struct Matrix3x3;
 
     template<typename T>
-    struct RotMatrix3x3; // to do
+    struct RotMatrix3x3;
 
     //------------------------------
 
@@ -57,6 +69,114 @@ namespace linal // structures declarations
     template<typename T>
     using Transform3dUniform = std::array<T, 16>;
 
+    //------------------------------
+
+    template<typename T>
+    struct Vector2SoA;
+
+    template<typename T>
+    struct ComplexSoA;
+
+    template<typename T>
+    struct Matrix2x2SoA;
+
+    template<typename T>
+    struct Intersection2;
+
+    template<typename T, unsigned table_bits>
+    struct BinaryAngleTable;
+
+    template<typename UIntT>
+    struct BinaryAngle;
+
+    template<typename T>
+    struct Vector3SoA;
+
+    template<typename T>
+    struct QuaternionSoA;
+
+    template<typename T>
+    struct Symmetric3SoA;
+
+    template<typename T>
+    struct KdTree3;
+
+    struct Parallel;
+
+    struct Executor;
+
+    struct Execution;
+
+    struct FrameArena;
+
+    struct FrameScope;
+
+    template<typename T, std::size_t components>
+    struct SoABuffer;
+
+    enum class ArrayElement : std::uint32_t;
+
+    enum class ArrayLayout : std::uint32_t;
+
+    struct ArrayFile;
+
+    enum class Summation;
+
+    enum class Integration;
+
+    template<typename T>
+    struct PointStatistics3;
+
+    template<typename T>
+    struct AnimationClip;
+
+    template<typename T, std::size_t dimensions>
+    struct CubicCurve;
+
+    template<typename T>
+    struct Fft;
+
+    template<typename T>
+    struct RealFft;
+
+    template<typename T>
+    struct FftConvolver;
+
+    template<typename T>
+    struct StdMath;
+
+    template<typename T>
+    struct FastMath;
+
+    template<typename T, std::size_t size>
+    struct Vector;
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    struct Matrix;
+
+    template<typename T>
+    struct ChainScan;
+
+    template<typename T>
+    struct Particles;
+
+    template<typename T>
+    struct MeshAttributes;
+
+    enum class DepthRange;
+
+    template<typename T>
+    struct Plane3;
+
+    template<typename T>
+    struct Frustum;
+
+    template<typename T>
+    struct Polygon2;
+
+    template<typename T>
+    struct Weld3;
+
 //==============================================================================================================================================
 
     template<typename T>
@@ -228,6 +348,70 @@ namespace linal // structures declarations
         template<typename MathT>
         Rotator2<T> Normalized(MathT&& sqrt_calculator) const;
 
+        // principal branches, cut along the negative real axis. Log() and Arg() use Abs2(), |z| should not overflow when squared
+        Complex<T> Exp() const noexcept;
+        Complex<T> Log() const noexcept;
+        Complex<T> Sqrt() const noexcept;
+        // exp(exponent * Log()). zero to a power is zero for Re(exponent) > 0, one for a zero exponent, infinity for Re(exponent) < 0
+        // and nan otherwise
+        Complex<T> Pow(const Complex<T>& exponent) const noexcept;
+        Complex<T> Pow(const T& exponent) const noexcept;
+        // angle in [-tau / 2, tau / 2]
+        T Arg() const noexcept;
+        // the math_calculator should have methods "Exp(const T&) -> T&&", "Log(const T&) -> T&&", "Sin(const T&) -> T&&", "Cos(const T&) -> T&&",
+        // "Atan2(const T& y, const T& x) -> T&&" and "Sqrt(const T&) -> T&&", like StdMath<T> or FastMath<T>
+        template<typename MathT>
+        Complex<T> Exp(MathT&& math_calculator) const noexcept;
+        template<typename MathT>
+        Complex<T> Log(MathT&& math_calculator) const noexcept;
+        template<typename MathT>
+        Complex<T> Sqrt(MathT&& math_calculator) const noexcept;
+        template<typename MathT>
+        Complex<T> Pow(const Complex<T>& exponent, MathT&& math_calculator) const noexcept;
+        template<typename MathT>
+        Complex<T> Pow(const T& exponent, MathT&& math_calculator) const noexcept;
+        template<typename MathT>
+        T Arg(MathT&& math_calculator) const noexcept;
+
+        static Complex<T> FromPolar(const T& radius, const T& angle) noexcept;
+        template<typename MathT>
+        static Complex<T> FromPolar(const T& radius, const T& angle, MathT&& math_calculator) noexcept;
+
+        // batch versions, every lane gives the same result as the scalar function with the same calculator. result may be the input
+        static void Exp(ComplexSoA<const T> z, ComplexSoA<T> result) noexcept;
+        static void Log(ComplexSoA<const T> z, ComplexSoA<T> result) noexcept;
+        static void Sqrt(ComplexSoA<const T> z, ComplexSoA<T> result) noexcept;
+        static void Pow(ComplexSoA<const T> z, const Complex<T>& exponent, ComplexSoA<T> result) noexcept;
+        // radius and angle have z.size elements
+        static void ToPolar(ComplexSoA<const T> z, T* radius, T* angle) noexcept;
+        static void FromPolar(const T* radius, const T* angle, ComplexSoA<T> result) noexcept;
+        template<typename MathT>
+        static void Exp(ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void Log(ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void Sqrt(ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void Pow(ComplexSoA<const T> z, const Complex<T>& exponent, ComplexSoA<T> result, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void ToPolar(ComplexSoA<const T> z, T* radius, T* angle, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void FromPolar(const T* radius, const T* angle, ComplexSoA<T> result, MathT&& math_calculator) noexcept;
+        template<typename MathT = StdMath<T>>
+        static void Exp(const Execution& execution, ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator = MathT());
+        template<typename MathT = StdMath<T>>
+        static void Log(const Execution& execution, ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator = MathT());
+        template<typename MathT = StdMath<T>>
+        static void Sqrt(const Execution& execution, ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator = MathT());
+        template<typename MathT = StdMath<T>>
+        static void Pow(const Execution& execution, ComplexSoA<const T> z, const Complex<T>& exponent, ComplexSoA<T> result,
+            MathT&& math_calculator = MathT());
+        template<typename MathT = StdMath<T>>
+        static void ToPolar(const Execution& execution, ComplexSoA<const T> z, T* radius, T* angle, MathT&& math_calculator = MathT());
+        template<typename MathT = StdMath<T>>
+        static void FromPolar(const Execution& execution, const T* radius, const T* angle, ComplexSoA<T> result,
+            MathT&& math_calculator = MathT());
+
         bool operator == (const Complex<T>& other) const noexcept;
         bool operator != (const Complex<T>& other) const noexcept;
         bool Compare(const Complex<T>& other, const T& epsilon2) const noexcept;
@@ -238,6 +422,17 @@ namespace linal // structures declarations
         static const Complex<T> one;
         static const Complex<T> i;
         static const Complex<T> zero;
+
+    private:
+        template<typename MathT>
+        static void ExpLane(const T& re, const T& im, T& result_re, T& result_im, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void LogLane(const T& re, const T& im, T& result_re, T& result_im, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void SqrtLane(const T& re, const T& im, T& result_re, T& result_im, MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void PowLane(const T& re, const T& im, const T& exponent_re, const T& exponent_im, T& result_re, T& result_im,
+            MathT&& math_calculator) noexcept;
     };
 
     using ComplexD = Complex<double>;
@@ -296,21 +491,33 @@ namespace linal // structures declarations
         template<typename MathT>
         static Rotator2<T> RadianRot(const T& angle, MathT&& sin_cos_calculator);
 
+        // to * conjugate(from) scaled by a single 1 / sqrt, identity if one of the vectors is zero
         static Rotator2<T> FromTo(const Vector2<T>& from, const Vector2<T>& to) noexcept;
-        // might have to use RepairFast() after it.
+        // no sqrt at all. might have to use RepairFast() after it.
         static Rotator2<T> FromTo(const Direction2<T>& from, const Direction2<T>& to) noexcept;
+        // the sqrt_calculator should have method "Sqrt(const T&) -> T&&"
         template<typename MathT>
         static Rotator2<T> FromTo(const Vector2<T>& from, const Vector2<T>& to, MathT&& sqrt_calculator) noexcept;
+        // rotator by half of the angle between the directions, (1 + from.Dot(to), cross) scaled by a single 1 / sqrt.
+        // exactly opposite directions give orthogonal_left
+        static Rotator2<T> HalfFromTo(const Direction2<T>& from, const Direction2<T>& to) noexcept;
+        static void FromTo(Vector2SoA<const T> from, Vector2SoA<const T> to, ComplexSoA<T> rotators) noexcept;
+        static void FromTo(const Execution& execution, Vector2SoA<const T> from, Vector2SoA<const T> to, ComplexSoA<T> rotators);
 
     private:
         Complex<T> value;
         
         friend struct Complex<T>;
+        friend struct Matrix2x2<T>;
+        template<typename UIntT>
+        friend struct BinaryAngle;
 
         explicit Rotator2(const Complex<T>& complex) noexcept;
         explicit Rotator2(Complex<T>&& complex) noexcept;
         Rotator2<T>& operator=(const Complex<T>& complex) noexcept;
         Rotator2<T>& operator=(Complex<T>&& complex) noexcept;
+
+        static void FromToLane(const T& from_x, const T& from_y, const T& to_x, const T& to_y, T& re, T& im) noexcept;
     };
 
     using Rotator2D = Rotator2<double>;
@@ -356,6 +563,10 @@ namespace linal // structures declarations
         // Inverse
         Matrix2x2<T> Inversed() const;
 
+        // x such that x * (*this + regularization * one) == b, by cramer's rule without forming the inverse.
+        // second is false and x is zero when the determinant is lost in rounding, relative to the products it is made of
+        std::pair<Vector2<T>, bool> Solve(const Vector2<T>& b, const T& regularization = T(0)) const noexcept;
+
         static const Matrix2x2<T> one;
         static const Matrix2x2<T> zero;
 
@@ -364,6 +575,50 @@ namespace linal // structures declarations
 
         static std::pair<Matrix2x2<T>, Vector2<T>> ReadTransform(const Transform2dUniform<T>& transform) noexcept;
         static std::pair<Matrix2x2<T>, Vector2<T>> ReadTransform(const Transform3dUniform<T>& transform) noexcept;
+
+        // closed forms without trigonometry, they never throw. T should be a floating point type.
+
+        // eigen values in descending order and the rotation whose matrix has the matching eigen vectors as columns.
+        // the matrix should be symmetric, only line0 and line1.y are read.
+        std::pair<Vector2<T>, Rotator2<T>> EigenSymmetric() const noexcept;
+        // *this == rotation.MakeMatrix() * stretch, stretch is symmetric (positive definite only if Det() > 0)
+        std::pair<Rotator2<T>, Matrix2x2<T>> PolarDecomposition() const noexcept;
+        // *this == u.MakeMatrix() * diag(sigma) * v.MakeMatrix().Transposed(), sigma.x >= |sigma.y|.
+        // sigma.y is negative if Det() < 0, so u and v stay rotations
+        std::tuple<Rotator2<T>, Vector2<T>, Rotator2<T>> SVD() const noexcept;
+
+        static void EigenSymmetric(Matrix2x2SoA<const T> matrices, Vector2SoA<T> values, ComplexSoA<T> bases) noexcept;
+        static void PolarDecomposition(Matrix2x2SoA<const T> matrices, ComplexSoA<T> rotations, Matrix2x2SoA<T> stretches) noexcept;
+        static void SVD(Matrix2x2SoA<const T> matrices, ComplexSoA<T> u, Vector2SoA<T> sigma, ComplexSoA<T> v) noexcept;
+        // same, split by the execution policy
+        static void EigenSymmetric(const Execution& execution, Matrix2x2SoA<const T> matrices, Vector2SoA<T> values, ComplexSoA<T> bases);
+        static void PolarDecomposition(const Execution& execution, Matrix2x2SoA<const T> matrices, ComplexSoA<T> rotations, Matrix2x2SoA<T> stretches);
+        static void SVD(const Execution& execution, Matrix2x2SoA<const T> matrices, ComplexSoA<T> u, Vector2SoA<T> sigma, ComplexSoA<T> v);
+
+        // batch Solve, branch free. solved is a mask written as 0 or 1 per element, x is zero where it is 0
+        static void Solve(Matrix2x2SoA<const T> matrices, Vector2SoA<const T> b, Vector2SoA<T> x, std::uint8_t* solved,
+            const T& regularization = T(0)) noexcept;
+        static void Solve(const Matrix2x2<T>* matrices, const Vector2<T>* b, Vector2<T>* x, std::uint8_t* solved, std::size_t count,
+            const T& regularization = T(0)) noexcept;
+        static void Solve(const Execution& execution, Matrix2x2SoA<const T> matrices, Vector2SoA<const T> b, Vector2SoA<T> x,
+            std::uint8_t* solved, const T& regularization = T(0));
+
+    private:
+        static void EigenSymmetricLane(
+            const T& xx, const T& xy, const T& yy,
+            T& value0, T& value1, T& re, T& im) noexcept;
+        static void PolarDecompositionLane(
+            const T& xx, const T& xy, const T& yx, const T& yy,
+            T& re, T& im, T& sxx, T& sxy, T& syy) noexcept;
+        static void SVDLane(
+            const T& xx, const T& xy, const T& yx, const T& yy,
+            T& u_re, T& u_im, T& sigma0, T& sigma1, T& v_re, T& v_im) noexcept;
+        // unit complex with half of the angle of (re, im), identity for zero
+        static void HalfAngleLane(const T& re, const T& im, T& half_re, T& half_im) noexcept;
+        static void SolveLane(
+            const T& xx, const T& xy, const T& yx, const T& yy,
+            const T& b_x, const T& b_y, const T& regularization,
+            T& x, T& y, std::uint8_t& solved) noexcept;
     };
 
     using Matrix2x2D = Matrix2x2<double>;
@@ -450,14 +705,14 @@ namespace linal // structures declarations
         bool operator!=(const Vector3<T>& other) const noexcept;
         bool Compare(const Vector3<T>& other, const T& epsilon2) const noexcept;
 
-        static constexpr Vector3<T> up = {0, 1, 0};
-        static constexpr Vector3<T> forward = {0, 0, 1};
-        static constexpr Vector3<T> right = {1, 0, 0};
-        static constexpr Vector3<T> left = -right;
-        static constexpr Vector3<T> down = -up;
-        static constexpr Vector3<T> back = -forward;
-        static constexpr Vector3<T> zero = {0, 0, 0};
-        static constexpr Vector3<T> ones = {1, 1, 1};
+        static const Vector3<T> up;
+        static const Vector3<T> forward;
+        static const Vector3<T> right;
+        static const Vector3<T> left;
+        static const Vector3<T> down;
+        static const Vector3<T> back;
+        static const Vector3<T> zero;
+        static const Vector3<T> ones;
     };
 
     using Vector3D = Vector3<double>;
@@ -535,22 +790,22 @@ namespace linal // structures declarations
         Matrix3x3<T>& operator-=(const Matrix3x3<T>& other) noexcept;
         Matrix3x3<T>& operator*=(const T& scalar) noexcept;
         Matrix3x3<T>& operator/=(const T& scalar);
-        Matrix3x3<T>& operator*=(const Matrix3x3<T>& other) const noexcept; // for gpt: define the method via operator *
+        Matrix3x3<T>& operator*=(const Matrix3x3<T>& other) noexcept;
 
         // Unary arithmetic operators
         Matrix3x3<T> operator-() const noexcept;
 
         // Binary arithmetic operators
-        Matrix3x3<T> operator+(const Matrix3x3<T>& other) const noexcept; // for gpt: define this method and others via copying and operator += or another changing operator 
+        Matrix3x3<T> operator+(const Matrix3x3<T>& other) const noexcept;
         Matrix3x3<T> operator-(const Matrix3x3<T>& other) const noexcept;
         Matrix3x3<T> operator*(const T& scalar) const noexcept;
         Matrix3x3<T> operator/(const T& scalar) const;
-        Matrix3x3<T> operator*(const Matrix3x3<T>& other) const noexcept; // for gpt: define the method via transpose and Vector3::Dot();
+        Matrix3x3<T> operator*(const Matrix3x3<T>& other) const noexcept;
 
         // Comparison operators
         bool operator==(const Matrix3x3<T>& other) const noexcept;
         bool operator!=(const Matrix3x3<T>& other) const noexcept;
-        bool Compare(const Matrix3x3<T>& other, const T& epsilon2) const noexcept; // for gpt: the method works like ==, but it is tolerant to arithmetical mistake.
+        bool Compare(const Matrix3x3<T>& other, const T& epsilon2) const noexcept;
 
         // Transpose
         Matrix3x3<T> Transposed() const noexcept;
@@ -567,12 +822,1669 @@ namespace linal // structures declarations
         Transform3dUniform<T> MakeTransform3D(const Vector3<T>& offset) const noexcept;
 
         static std::pair<Matrix3x3<T>, Vector3<T>> ReadTransform(const Transform3dUniform<T>& transform) noexcept;
+
+        // eigen values in descending order and the rotation whose matrix has the matching eigen vectors as columns.
+        // the matrix should be symmetric, only the upper triangle is read. cyclic jacobi with a fixed number of sweeps.
+        std::pair<Vector3<T>, Rotator3<T>> EigenSymmetric(std::size_t sweeps = 5) const noexcept;
+        // same for many matrices at once, the lanes of the jacobi sweeps are vectorized
+        static void EigenSymmetric(Symmetric3SoA<const T> matrices, Vector3SoA<T> values, QuaternionSoA<T> bases, std::size_t sweeps = 5) noexcept;
+        static void EigenSymmetric(const Execution& execution, Symmetric3SoA<const T> matrices, Vector3SoA<T> values, QuaternionSoA<T> bases, std::size_t sweeps = 5);
+
+    private:
+        // a is {xx, xy, xz, yy, yz, zz}, q is {re, x, y, z}
+        template<std::size_t lanes>
+        static void EigenSymmetricLanes(T (&a)[6][lanes], T (&q)[4][lanes], std::size_t sweeps) noexcept;
     };
 
     using Matrix3x3D = Matrix3x3<double>;
     using Matrix3x3F = Matrix3x3<float>;
     using Matrix3x3I = Matrix3x3<int>;
 
+//==============================================================================================================================================
+
+    // orientation update for an angular velocity given in the world frame
+    enum class Integration
+    {
+        first_order,    // q + (0, w) * q * dt / 2, renormalized
+        exponential     // exp((0, w) * dt / 2) * q, exact for a constant w
+    };
+
+    // unit quaternion
+    template<typename T>
+    struct Rotator3
+    {
+        // Constructors
+        Rotator3() = delete;
+        Rotator3(const Rotator3<T>& other) noexcept = default;
+        Rotator3(Rotator3<T>&& other) noexcept = default;
+        Rotator3<T>& operator=(const Rotator3<T>& other) noexcept = default;
+        Rotator3<T>& operator=(Rotator3<T>&& other) noexcept = default;
+
+        const T& GetRe() const noexcept;
+        const Vector3<T>& GetIm() const noexcept;
+
+        const Quaternion<T>& AsQuaternion() const noexcept;
+        operator const Quaternion<T>& () const noexcept;
+
+        RotMatrix3x3<T> MakeMatrix() const noexcept;
+
+        Rotator3<T> operator*(const Rotator3<T>& other) const noexcept;
+        Rotator3<T> operator/(const Rotator3<T>& other) const noexcept;
+
+        // same as conjugate
+        Rotator3<T> Inversed() const noexcept;
+
+        Rotator3<T>& RepairFast() noexcept;
+        Rotator3<T>& Repair();
+        // the sqrt_calculator should have method "Sqrt(const T&) -> T&&"
+        template<typename MathT>
+        Rotator3<T>& Repair(MathT&& sqrt_calculator);
+
+        bool operator==(const Rotator3<T>& other) const noexcept;
+        bool operator!=(const Rotator3<T>& other) const noexcept;
+        bool Compare(const Rotator3<T>& other, const T& epsilon2) const noexcept;
+
+        static const Rotator3<T> identity;
+
+        // inverse of MakeMatrix(), Shepperd's method with branch free selection of the largest component.
+        // the result is normalized, so slightly non orthogonal matrices are fine. re >= 0 in the result
+        static Rotator3<T> FromMatrix(const RotMatrix3x3<T>& matrix) noexcept;
+        static Rotator3<T> FromMatrix(const Matrix3x3<T>& matrix) noexcept;
+        // reads the rotation part of a transform made by Matrix3x3::MakeTransform3D, the transform should have no scale
+        static Rotator3<T> FromTransform(const Transform3dUniform<T>& transform) noexcept;
+        // rotators.size elements are converted
+        static void FromMatrix(const Matrix3x3<T>* matrices, QuaternionSoA<T> rotators) noexcept;
+        static void FromTransform(const Transform3dUniform<T>* transforms, QuaternionSoA<T> rotators) noexcept;
+        static void FromMatrix(const Execution& execution, const Matrix3x3<T>* matrices, QuaternionSoA<T> rotators);
+        static void FromTransform(const Execution& execution, const Transform3dUniform<T>* transforms, QuaternionSoA<T> rotators);
+
+        // shortest arc, (|from| * |to| + from.Dot(to), from.Cross(to)) normalized.
+        // (almost) opposite vectors give a half turn around an axis orthogonal to from, zero vectors give identity
+        static Rotator3<T> FromTo(const Vector3<T>& from, const Vector3<T>& to) noexcept;
+        static void FromTo(Vector3SoA<const T> from, Vector3SoA<const T> to, QuaternionSoA<T> rotators) noexcept;
+        static void FromTo(const Execution& execution, Vector3SoA<const T> from, Vector3SoA<const T> to, QuaternionSoA<T> rotators);
+
+        // one step of the rotation with the angular velocity during dt, the result is renormalized
+        Rotator3<T> Integrated(const Vector3<T>& angular_velocity, const T& dt, Integration integration = Integration::exponential) const noexcept;
+        // the math_calculator should have methods "RSqrt(const T&) -> T&&", "Sqrt(const T&) -> T&&", "Sin(const T&) -> T&&"
+        // and "Cos(const T&) -> T&&", like StdMath<T> or FastMath<T>
+        template<typename MathT>
+        Rotator3<T> Integrated(const Vector3<T>& angular_velocity, const T& dt, Integration integration, MathT&& math_calculator) const noexcept;
+        // rotators are updated in place, angular_velocities has rotators.size elements.
+        // one fused branch free pass, FastMath<T> keeps the exponential map in simd lanes
+        template<typename MathT = StdMath<T>>
+        static void Integrate(QuaternionSoA<T> rotators, Vector3SoA<const T> angular_velocities, const T& dt,
+            Integration integration = Integration::exponential, MathT&& math_calculator = MathT()) noexcept;
+        template<typename MathT = StdMath<T>>
+        static void Integrate(const Execution& execution, QuaternionSoA<T> rotators, Vector3SoA<const T> angular_velocities, const T& dt,
+            Integration integration = Integration::exponential, MathT&& math_calculator = MathT());
+
+    private:
+        Quaternion<T> value;
+
+        friend struct Quaternion<T>;
+        friend struct Matrix3x3<T>;
+
+        explicit Rotator3(const Quaternion<T>& quaternion) noexcept;
+        explicit Rotator3(Quaternion<T>&& quaternion) noexcept;
+
+        // m is the matrix line by line
+        static void FromMatrixLane(
+            const T& m00, const T& m01, const T& m02,
+            const T& m10, const T& m11, const T& m12,
+            const T& m20, const T& m21, const T& m22,
+            T& re, T& x, T& y, T& z) noexcept;
+        static void FromToLane(
+            const T& from_x, const T& from_y, const T& from_z,
+            const T& to_x, const T& to_y, const T& to_z,
+            T& re, T& x, T& y, T& z) noexcept;
+        // separate loops per kind, so the kind is not selected per lane
+        template<typename MathT>
+        static void FirstOrderLane(T& re, T& x, T& y, T& z, const T& wx, const T& wy, const T& wz, const T& half_dt,
+            MathT&& math_calculator) noexcept;
+        template<typename MathT>
+        static void ExponentialLane(T& re, T& x, T& y, T& z, const T& wx, const T& wy, const T& wz, const T& half_dt,
+            MathT&& math_calculator) noexcept;
+    };
+
+    using Rotator3D = Rotator3<double>;
+    using Rotator3F = Rotator3<float>;
+
+//==============================================================================================================================================
+
+    template<typename T>
+    struct RotMatrix3x3
+    {
+        // there is no riliable way to repair rot_matrix. not recomended to accumulate arithmetical error
+        RotMatrix3x3<T> operator*(const RotMatrix3x3<T>& other) const noexcept;
+
+        // same as transpose
+        RotMatrix3x3<T>& Inverse() noexcept;
+        // same as transposed
+        RotMatrix3x3<T> Inversed() const noexcept;
+
+        const Matrix3x3<T>& AsMatrix() const noexcept;
+        operator const Matrix3x3<T>& () const noexcept;
+
+        static const RotMatrix3x3<T> identity;
+
+    private:
+        friend struct Quaternion<T>;
+
+        Matrix3x3<T> value = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+        explicit RotMatrix3x3(const Matrix3x3<T>& matrix) noexcept;
+    };
+
+    using RotMatrix3x3D = RotMatrix3x3<double>;
+    using RotMatrix3x3F = RotMatrix3x3<float>;
+
+//##############################################################################################################################################
+
+    // view over vectors stored as structure of arrays, it does not own the memory.
+    // use Vector2SoA<const T> for read only data.
+    template<typename T>
+    struct Vector2SoA
+    {
+        T* x = nullptr;
+        T* y = nullptr;
+        std::size_t size = 0;
+
+        Vector2<std::remove_const_t<T>> Get(std::size_t index) const noexcept;
+        void Set(std::size_t index, const Vector2<std::remove_const_t<T>>& vector) const noexcept;
+
+        Vector2SoA<T> Slice(std::size_t offset, std::size_t count) const noexcept;
+
+        operator Vector2SoA<const T>() const noexcept;
+    };
+
+    using Vector2SoAD = Vector2SoA<double>;
+    using Vector2SoAF = Vector2SoA<float>;
+
+    // same as Vector2SoA, but for Complex
+    template<typename T>
+    struct ComplexSoA
+    {
+        T* re = nullptr;
+        T* im = nullptr;
+        std::size_t size = 0;
+
+        Complex<std::remove_const_t<T>> Get(std::size_t index) const noexcept;
+        void Set(std::size_t index, const Complex<std::remove_const_t<T>>& complex) const noexcept;
+
+        ComplexSoA<T> Slice(std::size_t offset, std::size_t count) const noexcept;
+
+        operator ComplexSoA<const T>() const noexcept;
+    };
+
+    using ComplexSoAD = ComplexSoA<double>;
+    using ComplexSoAF = ComplexSoA<float>;
+
+    // xy is line0.y, yx is line1.x
+    template<typename T>
+    struct Matrix2x2SoA
+    {
+        T* xx = nullptr;
+        T* xy = nullptr;
+        T* yx = nullptr;
+        T* yy = nullptr;
+        std::size_t size = 0;
+
+        Matrix2x2<std::remove_const_t<T>> Get(std::size_t index) const noexcept;
+        void Set(std::size_t index, const Matrix2x2<std::remove_const_t<T>>& matrix) const noexcept;
+
+        Matrix2x2SoA<T> Slice(std::size_t offset, std::size_t count) const noexcept;
+
+        operator Matrix2x2SoA<const T>() const noexcept;
+    };
+
+    using Matrix2x2SoAD = Matrix2x2SoA<double>;
+    using Matrix2x2SoAF = Matrix2x2SoA<float>;
+
+    // same as Vector2SoA, but for Vector3
+    template<typename T>
+    struct Vector3SoA
+    {
+        T* x = nullptr;
+        T* y = nullptr;
+        T* z = nullptr;
+        std::size_t size = 0;
+
+        Vector3<std::remove_const_t<T>> Get(std::size_t index) const noexcept;
+        void Set(std::size_t index, const Vector3<std::remove_const_t<T>>& vector) const noexcept;
+
+        Vector3SoA<T> Slice(std::size_t offset, std::size_t count) const noexcept;
+
+        operator Vector3SoA<const T>() const noexcept;
+    };
+
+    using Vector3SoAD = Vector3SoA<double>;
+    using Vector3SoAF = Vector3SoA<float>;
+
+    // same as Vector2SoA, but for Quaternion
+    template<typename T>
+    struct QuaternionSoA
+    {
+        T* re = nullptr;
+        T* x = nullptr;
+        T* y = nullptr;
+        T* z = nullptr;
+        std::size_t size = 0;
+
+        Quaternion<std::remove_const_t<T>> Get(std::size_t index) const noexcept;
+        void Set(std::size_t index, const Quaternion<std::remove_const_t<T>>& quaternion) const noexcept;
+
+        QuaternionSoA<T> Slice(std::size_t offset, std::size_t count) const noexcept;
+
+        operator QuaternionSoA<const T>() const noexcept;
+    };
+
+    using QuaternionSoAD = QuaternionSoA<double>;
+    using QuaternionSoAF = QuaternionSoA<float>;
+
+    // upper triangle of symmetric 3x3 matrices
+    template<typename T>
+    struct Symmetric3SoA
+    {
+        T* xx = nullptr;
+        T* xy = nullptr;
+        T* xz = nullptr;
+        T* yy = nullptr;
+        T* yz = nullptr;
+        T* zz = nullptr;
+        std::size_t size = 0;
+
+        Matrix3x3<std::remove_const_t<T>> Get(std::size_t index) const noexcept;
+        void Set(std::size_t index, const Matrix3x3<std::remove_const_t<T>>& matrix) const noexcept;
+
+        Symmetric3SoA<T> Slice(std::size_t offset, std::size_t count) const noexcept;
+
+        operator Symmetric3SoA<const T>() const noexcept;
+    };
+
+    using Symmetric3SoAD = Symmetric3SoA<double>;
+    using Symmetric3SoAF = Symmetric3SoA<float>;
+
+//==============================================================================================================================================
+
+    // monotonic arena for short lived batch buffers. every allocation is aligned at least to simd_alignment,
+    // deallocation does nothing, memory is taken back by Rewind() / Reset() or a FrameScope.
+    // chunks are kept after Reset(), so a steady frame loop does not allocate from upstream at all.
+    // not thread safe, use one arena per thread (ThreadLocal()).
+    struct FrameArena : std::pmr::memory_resource
+    {
+        static constexpr std::size_t default_chunk_size = std::size_t{1} << 20;
+
+        struct Marker
+        {
+            std::size_t chunk = 0;
+            std::size_t offset = 0;
+        };
+
+        explicit FrameArena(std::size_t chunk_size = default_chunk_size, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+        FrameArena(const FrameArena& other) = delete;
+        FrameArena& operator=(const FrameArena& other) = delete;
+        ~FrameArena() override;
+
+        Marker GetMarker() const noexcept;
+        // everything allocated after the marker is invalidated
+        void Rewind(const Marker& marker) noexcept;
+        void Reset() noexcept;
+        // gives the chunks back to upstream
+        void Release() noexcept;
+
+        std::size_t BytesReserved() const noexcept;
+
+        // arena of the calling thread
+        static FrameArena& ThreadLocal();
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        struct Chunk
+        {
+            unsigned char* data;
+            std::size_t size;
+        };
+
+        std::pmr::memory_resource* upstream;
+        std::size_t chunk_size;
+        std::vector<Chunk> chunks;
+        Marker top;
+    };
+
+    // rewinds the arena to the state it had at construction, scopes can be nested
+    struct FrameScope
+    {
+        explicit FrameScope(FrameArena& arena = FrameArena::ThreadLocal()) noexcept;
+        FrameScope(const FrameScope& other) = delete;
+        FrameScope& operator=(const FrameScope& other) = delete;
+        ~FrameScope();
+
+        FrameArena& GetArena() const noexcept;
+
+    private:
+        FrameArena& arena;
+        FrameArena::Marker marker;
+    };
+
+    // owning storage behind the SoA views, every component array starts at simd_alignment.
+    // memory comes from a memory resource (FrameArena for per frame data). moving keeps the addresses.
+    // T should be trivially copyable.
+    template<typename T, std::size_t components>
+    struct SoABuffer
+    {
+        explicit SoABuffer(std::size_t size = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        SoABuffer(const SoABuffer<T, components>& other) = delete;
+        SoABuffer(SoABuffer<T, components>&& other) noexcept;
+        SoABuffer<T, components>& operator=(const SoABuffer<T, components>& other) = delete;
+        SoABuffer<T, components>& operator=(SoABuffer<T, components>&& other) noexcept;
+        ~SoABuffer();
+
+        // keeps the first min(size, Size()) elements of every component
+        void Resize(std::size_t size);
+        std::size_t Size() const noexcept;
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        T* Component(std::size_t component) noexcept;
+        const T* Component(std::size_t component) const noexcept;
+
+        Vector2SoA<T> AsVector2() noexcept;
+        Vector2SoA<const T> AsVector2() const noexcept;
+        ComplexSoA<T> AsComplex() noexcept;
+        ComplexSoA<const T> AsComplex() const noexcept;
+        Vector3SoA<T> AsVector3() noexcept;
+        Vector3SoA<const T> AsVector3() const noexcept;
+        QuaternionSoA<T> AsQuaternion() noexcept;
+        QuaternionSoA<const T> AsQuaternion() const noexcept;
+        Matrix2x2SoA<T> AsMatrix2x2() noexcept;
+        Matrix2x2SoA<const T> AsMatrix2x2() const noexcept;
+        Symmetric3SoA<T> AsSymmetric3() noexcept;
+        Symmetric3SoA<const T> AsSymmetric3() const noexcept;
+
+    private:
+        std::pmr::memory_resource* resource;
+        T* data = nullptr;
+        std::size_t size = 0;
+        std::size_t stride = 0; // elements between components
+
+        static std::size_t Stride(std::size_t size) noexcept;
+    };
+
+    template<typename T>
+    using Vector2Buffer = SoABuffer<T, 2>;
+    template<typename T>
+    using ComplexBuffer = SoABuffer<T, 2>;
+    template<typename T>
+    using Vector3Buffer = SoABuffer<T, 3>;
+    template<typename T>
+    using QuaternionBuffer = SoABuffer<T, 4>;
+    template<typename T>
+    using Matrix2x2Buffer = SoABuffer<T, 4>;
+    template<typename T>
+    using Symmetric3Buffer = SoABuffer<T, 6>;
+
+//==============================================================================================================================================
+
+    enum class ArrayElement : std::uint32_t
+    {
+        vector2 = 1,
+        complex = 2,
+        vector3 = 3,
+        quaternion = 4
+    };
+
+    enum class ArrayLayout : std::uint32_t
+    {
+        aos = 0,    // elements one after another, same as an array of Vector3 / Quaternion
+        soa = 1     // every component is a separate aligned array, ready for the SoA views
+    };
+
+    // versioned binary file with one array of vectors or quaternions, stored in native byte order:
+    // header (element, layout, scalar type, count, alignment, checksum), then the aligned payload.
+    // reading maps the file, so opening is immediate and pages are loaded on first access.
+    // the checksum is only checked by Verify(), which reads the whole payload.
+    struct ArrayFile
+    {
+        static constexpr std::uint32_t version = 1;
+
+        ArrayFile() = default;
+        ArrayFile(const ArrayFile& other) = delete;
+        ArrayFile(ArrayFile&& other) noexcept;
+        ArrayFile& operator=(const ArrayFile& other) = delete;
+        ArrayFile& operator=(ArrayFile&& other) noexcept;
+        ~ArrayFile();
+
+        // maps the file read only, throws std::runtime_error if it is not a valid array file
+        explicit ArrayFile(const std::string& path);
+
+        // alignment of the payload and of every component, at least simd_alignment, must be a power of 2
+        template<typename T>
+        static void Write(const std::string& path, Vector2SoA<const T> data, ArrayLayout layout = ArrayLayout::soa, std::size_t alignment = simd_alignment);
+        template<typename T>
+        static void Write(const std::string& path, ComplexSoA<const T> data, ArrayLayout layout = ArrayLayout::soa, std::size_t alignment = simd_alignment);
+        template<typename T>
+        static void Write(const std::string& path, Vector3SoA<const T> data, ArrayLayout layout = ArrayLayout::soa, std::size_t alignment = simd_alignment);
+        template<typename T>
+        static void Write(const std::string& path, QuaternionSoA<const T> data, ArrayLayout layout = ArrayLayout::soa, std::size_t alignment = simd_alignment);
+        // ElementT is Vector2<T>, Complex<T>, Vector3<T> or Quaternion<T>
+        template<typename ElementT>
+        static void Write(const std::string& path, const ElementT* data, std::size_t count, ArrayLayout layout = ArrayLayout::aos, std::size_t alignment = simd_alignment);
+
+        ArrayElement Element() const noexcept;
+        ArrayLayout Layout() const noexcept;
+        std::size_t Size() const noexcept;
+        std::size_t ScalarSize() const noexcept;
+
+        // zero copy views of soa files, throw std::runtime_error if the element, layout or scalar type differ
+        template<typename T>
+        Vector2SoA<const T> AsVector2() const;
+        template<typename T>
+        ComplexSoA<const T> AsComplex() const;
+        template<typename T>
+        Vector3SoA<const T> AsVector3() const;
+        template<typename T>
+        QuaternionSoA<const T> AsQuaternion() const;
+        // zero copy view of aos files
+        template<typename ElementT>
+        const ElementT* AsArray() const;
+
+        // recomputes the checksum of the payload
+        bool Verify() const noexcept;
+        // asks the system to start loading the payload in the background
+        void Prefetch() const noexcept;
+
+    private:
+        struct Header
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint32_t element;
+            std::uint32_t layout;
+            std::uint32_t scalar_kind;
+            std::uint32_t scalar_size;
+            std::uint32_t components;
+            std::uint32_t alignment;
+            std::uint64_t count;
+            std::uint64_t stride;       // scalars between soa components
+            std::uint64_t data_offset;
+            std::uint64_t data_size;
+            std::uint64_t checksum;
+        };
+
+        // hash of the payload, fed in blocks of 32 bytes
+        struct Checksum
+        {
+            std::uint64_t lanes[4] =
+            {
+                0x9e3779b185ebca87ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull, 0x27d4eb2f165667c5ull
+            };
+            std::uint64_t size = 0;
+
+            void Add(const unsigned char* data, std::size_t size) noexcept;
+            std::uint64_t Value() const noexcept;
+        };
+
+        template<typename ElementT>
+        struct Traits;
+
+        SoABuffer<unsigned char, 1> storage; // used instead of the mapping where mapping is not available
+        const unsigned char* image = nullptr;
+        std::size_t image_size = 0;
+        Header header = {};
+
+        template<typename T>
+        static constexpr std::uint32_t ScalarKind() noexcept;
+        template<typename T>
+        void Check(ArrayElement element, ArrayLayout layout) const;
+        template<typename T>
+        const T* Component(std::size_t component) const noexcept;
+        static void WriteFile(const std::string& path, ArrayElement element, std::uint32_t scalar_kind, std::size_t scalar_size,
+            std::size_t components, const unsigned char* const* sources, std::size_t source_stride, std::size_t count,
+            ArrayLayout layout, std::size_t alignment);
+        void Unmap() noexcept;
+    };
+
+//==============================================================================================================================================
+
+    // user supplied thread pool. Run calls task(i) for every i in [0, tasks) and returns when all of them are done,
+    // the tasks do not throw.
+    struct Executor
+    {
+        virtual ~Executor() = default;
+        virtual void Run(std::size_t tasks, const std::function<void(std::size_t)>& task) = 0;
+    };
+
+    // how a batch operation runs. an unsigned thread count converts to a parallel policy,
+    // so every batch operation takes the same parameter.
+    // unsequenced runs on the calling thread like sequenced, the batch kernels are written as branch free loops for simd.
+    struct Execution
+    {
+        enum class Kind
+        {
+            sequenced,
+            unsequenced,
+            parallel
+        };
+
+        Kind kind = Kind::parallel;
+        unsigned thread_count = 0;      // 0 means std::thread::hardware_concurrency()
+        Executor* executor = nullptr;   // parallel chunks run on it instead of new threads
+
+        Execution(unsigned thread_count = 0) noexcept;
+        Execution(Kind kind, unsigned thread_count = 0, Executor* executor = nullptr) noexcept;
+
+        static Execution On(Executor& executor, unsigned thread_count = 0) noexcept;
+
+        // number of chunks the work is split into, 1 for sequenced and unsequenced
+        unsigned ThreadCount() const noexcept;
+
+        static const Execution sequenced;
+        static const Execution unsequenced;
+        static const Execution parallel;
+    };
+
+    struct Parallel
+    {
+        // elements per chunk for elementwise batch kernels, a multiple of the cache line for every scalar type,
+        // so chunks of aligned outputs never share a cache line
+        static constexpr std::size_t batch_grain = 4096;
+
+        // thread_count == 0 means std::thread::hardware_concurrency()
+        static unsigned ThreadCount(unsigned thread_count) noexcept;
+
+        // calls function(begin, end) for contiguous chunks of [0, count). chunk bounds are multiples of grain,
+        // so they only depend on count, grain and the thread count.
+        // the calling thread takes part in the work. the first exception thrown by function is rethrown after all chunks are done.
+        template<typename FunctionT>
+        static void For(std::size_t count, std::size_t grain, FunctionT&& function, const Execution& execution = Execution());
+    };
+
+//==============================================================================================================================================
+
+    // batch intersection tests over Vector2SoA. all of them are branch free and never throw,
+    // degenerate (parallel or zero length) input is reported as a miss in the hit mask.
+    // hit masks are written as 0 or 1 per element. T should be a floating point type.
+    template<typename T>
+    struct Intersection2
+    {
+        // segment a0[i]->a1[i] against segment b0[i]->b1[i].
+        // intersection point is a0 + (a1 - a0) * t[i] == b0 + (b1 - b0) * u[i]
+        static void SegmentSegment(
+            Vector2SoA<const T> a0, Vector2SoA<const T> a1,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t, T* u) noexcept;
+
+        // segment a0->a1 against every segment b0[i]->b1[i]
+        static void SegmentSegment(
+            const Vector2<T>& a0, const Vector2<T>& a1,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t, T* u) noexcept;
+
+        // ray origin + direction * t[i] (t >= 0) against every segment b0[i]->b1[i]
+        static void RaySegment(
+            const Vector2<T>& origin, const Vector2<T>& direction,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t) noexcept;
+
+        // ray origin[i] + direction[i] * t[i] (t >= 0) against segment b0[i]->b1[i]
+        static void RaySegment(
+            Vector2SoA<const T> origin, Vector2SoA<const T> direction,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t) noexcept;
+
+        // closest hit of the ray against all the segments, returns index of the segment or b0.size if nothing is hit.
+        // t gets the ray parameter of the hit.
+        static std::size_t RayCast(
+            const Vector2<T>& origin, const Vector2<T>& direction,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            T& t) noexcept;
+
+        // even-odd rule, polygon is a closed loop of vertices without the repeated first vertex
+        static void PointInPolygon(Vector2SoA<const T> points, Vector2SoA<const T> polygon, std::uint8_t* inside) noexcept;
+
+        // same as above, split by the execution policy. RayCast returns the same index for any policy
+        static void SegmentSegment(const Execution& execution,
+            Vector2SoA<const T> a0, Vector2SoA<const T> a1,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t, T* u);
+        static void SegmentSegment(const Execution& execution,
+            const Vector2<T>& a0, const Vector2<T>& a1,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t, T* u);
+        static void RaySegment(const Execution& execution,
+            const Vector2<T>& origin, const Vector2<T>& direction,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t);
+        static void RaySegment(const Execution& execution,
+            Vector2SoA<const T> origin, Vector2SoA<const T> direction,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            std::uint8_t* hit, T* t);
+        static std::size_t RayCast(const Execution& execution,
+            const Vector2<T>& origin, const Vector2<T>& direction,
+            Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+            T& t);
+        static void PointInPolygon(const Execution& execution, Vector2SoA<const T> points, Vector2SoA<const T> polygon, std::uint8_t* inside);
+
+    private:
+        // a + r * t == b + s * u, returns 1 if t is in [0, t_max] and u is in [0, 1]
+        static std::uint8_t Lane(
+            const T& ax, const T& ay, const T& rx, const T& ry,
+            const T& bx, const T& by, const T& sx, const T& sy,
+            const T& t_max, T& t, T& u) noexcept;
+    };
+
+    using Intersection2D = Intersection2<double>;
+    using Intersection2F = Intersection2<float>;
+
+//==============================================================================================================================================
+
+    // cos and sin of 2^table_bits steps of a full turn, generated at compile time.
+    // re[2^table_bits] and im[2^table_bits] repeat the first entry, so interpolation never wraps.
+    template<typename T, unsigned table_bits>
+    struct BinaryAngleTable
+    {
+        static constexpr std::size_t size = std::size_t{1} << table_bits;
+
+        static constexpr std::array<T, size + 1> re = BinaryAngleTable<T, table_bits>::Make(true);
+        static constexpr std::array<T, size + 1> im = BinaryAngleTable<T, table_bits>::Make(false);
+
+    private:
+        static constexpr std::array<T, size + 1> Make(bool cosine) noexcept;
+        // x in [0, tau / 4]
+        static constexpr long double Cos(long double x) noexcept;
+        static constexpr long double Sin(long double x) noexcept;
+    };
+
+    // angle as a fraction of a full turn, 2^bits steps. arithmetic wraps around exactly.
+    template<typename UIntT>
+    struct BinaryAngle
+    {
+        static_assert(std::is_unsigned<UIntT>::value && sizeof(UIntT) <= 4, "binary angle should be an unsigned integer up to 32 bits");
+        static constexpr unsigned bits = sizeof(UIntT) * CHAR_BIT;
+
+        UIntT value = 0;
+
+        constexpr BinaryAngle<UIntT>& operator+=(const BinaryAngle<UIntT>& other) noexcept;
+        constexpr BinaryAngle<UIntT>& operator-=(const BinaryAngle<UIntT>& other) noexcept;
+        constexpr BinaryAngle<UIntT> operator+(const BinaryAngle<UIntT>& other) const noexcept;
+        constexpr BinaryAngle<UIntT> operator-(const BinaryAngle<UIntT>& other) const noexcept;
+        constexpr BinaryAngle<UIntT> operator-() const noexcept;
+
+        constexpr bool operator==(const BinaryAngle<UIntT>& other) const noexcept;
+        constexpr bool operator!=(const BinaryAngle<UIntT>& other) const noexcept;
+
+        // rounds to the nearest step, any angle is accepted
+        template<typename T>
+        static BinaryAngle<UIntT> FromRadians(const T& angle) noexcept;
+        // in [0, tau)
+        template<typename T>
+        T ToRadians() const noexcept;
+
+        // nearest entry of the table, exactly unit. table_bits <= bits
+        template<typename T, unsigned table_bits = 12>
+        Rotator2<T> ToRotator() const noexcept;
+        // linear interpolation between the entries, might have to use RepairFast() after it
+        template<typename T, unsigned table_bits = 12>
+        Rotator2<T> ToRotatorLerp() const noexcept;
+        // rotators.size elements are converted, the loop is vectorized with gathers from the table
+        template<typename T, unsigned table_bits = 12>
+        static void ToRotators(const BinaryAngle<UIntT>* angles, ComplexSoA<T> rotators, bool interpolate = false) noexcept;
+        template<typename T, unsigned table_bits = 12>
+        static void ToRotators(const Execution& execution, const BinaryAngle<UIntT>* angles, ComplexSoA<T> rotators, bool interpolate = false);
+
+        static const BinaryAngle<UIntT> zero;
+        static const BinaryAngle<UIntT> quarter;
+        static const BinaryAngle<UIntT> half;
+    };
+
+    using BinaryAngle16 = BinaryAngle<std::uint16_t>;
+    using BinaryAngle32 = BinaryAngle<std::uint32_t>;
+
+//==============================================================================================================================================
+
+    // flat k-d tree over points. internal nodes form an implicit complete binary tree (children of node n are 2n+1 and 2n+2)
+    // built by median splits, points are reordered into leaf buckets stored as structure of arrays.
+    // the whole tree lives in one binary image, so it can be saved and later used in place (for example from a mapped file).
+    // indices returned by queries are positions in the span the tree was built from.
+    template<typename T>
+    struct KdTree3
+    {
+        static constexpr std::uint32_t npos = UINT32_MAX;
+        static constexpr std::size_t max_bucket_size = 256;
+
+        KdTree3() = default;
+        KdTree3(const KdTree3<T>& other) = delete;
+        KdTree3(KdTree3<T>&& other) noexcept = default;
+        KdTree3<T>& operator=(const KdTree3<T>& other) = delete;
+        KdTree3<T>& operator=(KdTree3<T>&& other) noexcept = default;
+
+        // the points are copied into the tree. bucket_size is clamped to [1, max_bucket_size]
+        explicit KdTree3(Vector3SoA<const T> points, std::size_t bucket_size = 32, const Execution& execution = Execution(),
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        std::size_t Size() const noexcept;
+
+        // k nearest points sorted by distance. if the tree has less than k points, the tail is filled with npos and infinity
+        void Nearest(const Vector3<T>& query, std::size_t k, std::uint32_t* indices, T* distances2) const noexcept;
+        // k nearest points for every query, results of query i start at indices[i * k] and distances2[i * k]
+        void Nearest(Vector3SoA<const T> queries, std::size_t k, std::uint32_t* indices, T* distances2, const Execution& execution = Execution()) const;
+
+        // every point with distance <= radius, unsorted. the indices are appended
+        void Radius(const Vector3<T>& query, const T& radius, std::vector<std::uint32_t>& indices) const;
+        // results of query i are indices[offsets[i] .. offsets[i + 1])
+        void Radius(Vector3SoA<const T> queries, const T& radius, std::vector<std::size_t>& offsets, std::vector<std::uint32_t>& indices, const Execution& execution = Execution()) const;
+
+        // binary image of the tree in native byte order
+        const unsigned char* ImageData() const noexcept;
+        std::size_t ImageSize() const noexcept;
+
+        // uses the image in place, the image must outlive the tree and be aligned at least to alignof(std::max_align_t)
+        static KdTree3<T> View(const void* image, std::size_t size);
+        // copies the image
+        static KdTree3<T> Load(const void* image, std::size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    private:
+        struct Header
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint32_t scalar_size;
+            std::uint32_t depth;
+            std::uint64_t size;
+            std::uint64_t bucket_size;
+        };
+
+        static constexpr std::size_t image_alignment = 64;
+        static constexpr std::uint32_t image_version = 1;
+
+        SoABuffer<unsigned char, 1> storage; // empty if the tree views an external image
+        const unsigned char* image = nullptr;
+        std::size_t image_size = 0;
+
+        std::size_t size = 0;
+        std::size_t depth = 0;
+        std::size_t bucket_size = 0;
+        const T* split = nullptr;
+        const std::uint8_t* axis = nullptr;
+        Vector3SoA<const T> points;
+        const std::uint32_t* index = nullptr;
+
+        static std::size_t ImageLayout(std::size_t size, std::size_t depth, std::array<std::size_t, 7>& offsets) noexcept;
+        void Attach(const unsigned char* image, std::size_t size);
+        // median split of one node, order[begin, end) is partitioned around the middle
+        void Split(Vector3SoA<const T> source, std::uint32_t* order, T* split, std::uint8_t* axis,
+            std::size_t node, std::size_t begin, std::size_t end) const;
+        // the subtree of node
+        void Build(Vector3SoA<const T> source, std::uint32_t* order, T* split, std::uint8_t* axis,
+            std::size_t node, std::size_t begin, std::size_t end, std::size_t level) const;
+    };
+
+    using KdTree3D = KdTree3<double>;
+    using KdTree3F = KdTree3<float>;
+
+//==============================================================================================================================================
+
+    enum class Summation
+    {
+        plain,
+        kahan,      // compensated sums per lane, do not compile it with fast math
+        pairwise    // blocks are merged as a balanced tree
+    };
+
+    // centroid, bounds and covariance of a point set.
+    // sums are taken relative to the first point of every block and blocks are combined with Merge(),
+    // so large offsets of the whole set do not destroy the covariance.
+    template<typename T>
+    struct PointStatistics3
+    {
+        std::size_t count = 0;
+        Vector3<T> mean = { 0, 0, 0 };
+        Vector3<T> lower = { std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max() };
+        Vector3<T> upper = { std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest() };
+        // sum of (point - mean) * (point - mean)^T
+        Matrix3x3<T> comoment = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
+
+        PointStatistics3<T>& Add(const Vector3<T>& point) noexcept;
+        // works for any split of the input, so chunks can be computed separately or streamed
+        PointStatistics3<T>& Merge(const PointStatistics3<T>& other) noexcept;
+
+        // comoment / count, zero for an empty set
+        Matrix3x3<T> Covariance() const noexcept;
+        // comoment / (count - 1), zero for less than 2 points
+        Matrix3x3<T> SampleCovariance() const noexcept;
+
+        // the result does not depend on the execution
+        static PointStatistics3<T> Compute(Vector3SoA<const T> points, Summation summation = Summation::plain, const Execution& execution = Execution());
+
+        // eigen decomposition of the covariance, the last axis is the normal of a planar set
+        std::pair<Vector3<T>, Rotator3<T>> PrincipalAxes() const noexcept;
+
+    private:
+        static constexpr std::size_t block_size = std::size_t{1} << 16;
+        static constexpr std::size_t pairwise_block_size = std::size_t{1} << 10;
+
+        template<bool compensated>
+        static PointStatistics3<T> Accumulate(Vector3SoA<const T> points) noexcept;
+        static PointStatistics3<T> AccumulatePairwise(Vector3SoA<const T> points) noexcept;
+    };
+
+    using PointStatistics3D = PointStatistics3<double>;
+    using PointStatistics3F = PointStatistics3<float>;
+
+//==============================================================================================================================================
+
+    // uniformly sampled rotation (Quaternion) and vector (translation, scale) tracks, quantized to 16 bits.
+    // keys are grouped by time segments of segment_frames frames, inside a segment every key stores each component
+    // of all tracks contiguously, so a sample reads two keys of one segment and blends all tracks in simd friendly loops.
+    // rotations are blended with nlerp, vectors with lerp. vector keys are quantized relative to the range of their segment.
+    template<typename T>
+    struct AnimationClip
+    {
+        static constexpr std::size_t default_segment_frames = 16;
+
+        // incremental sampler for playback. keeps the two current keys decoded,
+        // so advancing inside a key interval only blends and advancing to the next key decodes one key.
+        struct Cursor
+        {
+            explicit Cursor(const AnimationClip<T>& clip, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+            // same result as AnimationClip::Sample, any time order is allowed but monotonic time is the fast path
+            void Sample(const T& time, QuaternionSoA<T> rotations, Vector3SoA<T> vectors);
+
+        private:
+            const AnimationClip<T>* clip;
+            std::size_t frame = SIZE_MAX; // frame of keys[current], the other slot has frame + 1
+            std::size_t current = 0;
+            QuaternionBuffer<T> rotation_keys[2];
+            Vector3Buffer<T> vector_keys[2];
+
+            // key frame + offset of the interval starting at frame
+            void Decode(std::size_t slot, std::size_t frame, std::size_t offset) noexcept;
+        };
+
+        AnimationClip() = default;
+        // key of track t at frame f is element f * track count + t, rotation keys are normalized on input
+        AnimationClip(QuaternionSoA<const T> rotation_keys, std::size_t rotation_tracks,
+            Vector3SoA<const T> vector_keys, std::size_t vector_tracks,
+            std::size_t frame_count, const T& frame_rate, std::size_t segment_frames = default_segment_frames);
+
+        std::size_t RotationTracks() const noexcept;
+        std::size_t VectorTracks() const noexcept;
+        std::size_t FrameCount() const noexcept;
+        T Duration() const noexcept;
+
+        // time is clamped to [0, Duration()], outputs have one element per track
+        void Sample(const T& time, QuaternionSoA<T> rotations, Vector3SoA<T> vectors) const noexcept;
+
+    private:
+        std::size_t rotation_tracks = 0;
+        std::size_t vector_tracks = 0;
+        std::size_t frame_count = 0;
+        std::size_t segment_frames = default_segment_frames;
+        T frame_rate = 1;
+        std::vector<std::int16_t> rotation_data;    // [segment][key][component][track]
+        std::vector<std::uint16_t> vector_data;     // [segment][key][component][track]
+        std::vector<T> vector_ranges;               // [segment][min, step][component][track]
+
+        // frame is the first key of the interval, both keys of the interval are in one segment
+        void Locate(const T& time, std::size_t& frame, T& alpha) const noexcept;
+        const std::int16_t* RotationKey(std::size_t frame) const noexcept;
+        const std::uint16_t* VectorKey(std::size_t frame) const noexcept;
+        const T* VectorRange(std::size_t frame) const noexcept;
+
+        // a[c] and b[c] are the component c of two keys for all tracks
+        template<typename KeyT>
+        static void BlendRotations(const KeyT* const* a, const KeyT* const* b, const T& alpha, QuaternionSoA<T> rotations) noexcept;
+        template<typename KeyT>
+        static void BlendVectors(const KeyT* const* a, const KeyT* const* b, const T* range, const T& alpha, Vector3SoA<T> vectors) noexcept;
+    };
+
+    using AnimationClipD = AnimationClip<double>;
+    using AnimationClipF = AnimationClip<float>;
+
+//==============================================================================================================================================
+
+    // cubic curve segment in power basis P(t) = a t^3 + b t^2 + c t + d for t in [0, 1].
+    // Bezier, Hermite and Catmull-Rom segments are converted on construction, so every kind is evaluated the same way.
+    // dimensions is 2 (Vector2, Vector2SoA) or 3 (Vector3, Vector3SoA)
+    template<typename T, std::size_t dimensions>
+    struct CubicCurve
+    {
+        static_assert(dimensions == 2 || dimensions == 3, "CubicCurve supports 2 and 3 dimensions");
+
+        using VectorT = std::conditional_t<dimensions == 2, Vector2<T>, Vector3<T>>;
+        using SoAT = std::conditional_t<dimensions == 2, Vector2SoA<T>, Vector3SoA<T>>;
+
+        static CubicCurve<T, dimensions> Bezier(const VectorT& p0, const VectorT& p1, const VectorT& p2, const VectorT& p3) noexcept;
+        // endpoints and tangents at the endpoints
+        static CubicCurve<T, dimensions> Hermite(const VectorT& p0, const VectorT& m0, const VectorT& p1, const VectorT& m1) noexcept;
+        // uniform Catmull-Rom segment from p1 to p2
+        static CubicCurve<T, dimensions> CatmullRom(const VectorT& p0, const VectorT& p1, const VectorT& p2, const VectorT& p3) noexcept;
+
+        VectorT Evaluate(const T& t) const noexcept;
+        VectorT Derivative(const T& t) const noexcept;
+        // Bezier control points of the same curve
+        std::array<VectorT, 4> ControlPoints() const noexcept;
+
+        // points[i] = P(parameters[i])
+        void Evaluate(const T* parameters, SoAT points) const noexcept;
+        // points.size uniform samples from P(t0) to P(t1) by forward differencing, rounding error grows with the count
+        void EvaluateUniform(const T& t0, const T& t1, SoAT points) const noexcept;
+        // samples uniform samples of every curve from t = 0 to 1, curve i starts at points[i * samples]
+        static void EvaluateUniform(const CubicCurve<T, dimensions>* curves, std::size_t count, std::size_t samples, SoAT points, const Execution& execution = Execution());
+
+        // appends a polyline from P(0) to P(1) with distance to the curve below tolerance, P(0) included
+        void Flatten(const T& tolerance, std::vector<VectorT>& polyline) const;
+        // polyline of curve i is points[offsets[i] .. offsets[i + 1]), the output does not depend on the execution
+        static void Flatten(const CubicCurve<T, dimensions>* curves, std::size_t count, const T& tolerance,
+            std::vector<std::size_t>& offsets, std::vector<VectorT>& points, const Execution& execution = Execution());
+
+        // cumulative arc length at t = i / segments, i in [0, segments], by Gauss-Legendre quadrature per segment
+        std::vector<T> ArcLengthTable(std::size_t segments) const;
+        // inverse of the table, lengths outside [0, table.back()] are clamped
+        static T ParameterAt(const std::vector<T>& table, const T& length) noexcept;
+        static void ParametersAt(const std::vector<T>& table, const T* lengths, T* parameters, std::size_t count) noexcept;
+
+    private:
+        // curves per chunk for the batch overloads. a curve is a whole run of samples or a recursive flattening,
+        // so far fewer of them than Parallel::batch_grain elements fill a chunk
+        static constexpr std::size_t curve_grain = 1024;
+
+        T coefficients[4][dimensions] = {}; // a, b, c, d
+
+        static std::array<T, dimensions> Components(const VectorT& vector) noexcept;
+        static VectorT Compose(const T* components) noexcept;
+        static CubicCurve<T, dimensions> FromBasis(const VectorT& p0, const VectorT& p1, const VectorT& p2, const VectorT& p3, const T (&basis)[4][4]) noexcept;
+    };
+
+    template<typename T>
+    using CubicCurve2 = CubicCurve<T, 2>;
+    template<typename T>
+    using CubicCurve3 = CubicCurve<T, 3>;
+
+    using CubicCurve2D = CubicCurve<double, 2>;
+    using CubicCurve2F = CubicCurve<float, 2>;
+    using CubicCurve3D = CubicCurve<double, 3>;
+    using CubicCurve3F = CubicCurve<float, 3>;
+
+//==============================================================================================================================================
+
+    // discrete fourier transform plan for one size, X[k] = sum x[j] * exp(-i * tau * j * k / n).
+    // the size is factored into radix 4, 2 and odd prime passes of a Stockham autosort, so no bit reversal is needed.
+    // the plan keeps the twiddles of every pass, executing it does not allocate outside of FrameArena::ThreadLocal().
+    // the passes work on split (ComplexSoA) data with the inner loops over contiguous elements,
+    // interleaved Complex arrays are split on the way in and merged on the way out.
+    // large prime factors p cost O(n * p). a plan can be used from several threads at once.
+    template<typename T>
+    struct Fft
+    {
+        Fft() = default;
+        explicit Fft(std::size_t size);
+
+        std::size_t Size() const noexcept;
+        // radices of the passes in order
+        std::vector<std::size_t> Radices() const;
+
+        // input and output have Size() elements and may be the same
+        void Forward(ComplexSoA<const T> input, ComplexSoA<T> output) const;
+        // scaled by 1 / Size(), so Inverse(Forward(x)) == x
+        void Inverse(ComplexSoA<const T> input, ComplexSoA<T> output) const;
+        void Forward(const Complex<T>* input, Complex<T>* output) const;
+        void Inverse(const Complex<T>* input, Complex<T>* output) const;
+
+    private:
+        friend struct FftConvolver<T>;
+
+        struct Pass
+        {
+            std::size_t radix;
+            std::size_t length;     // m, the sub transform length after the pass
+            std::size_t stride;     // s, distance between elements of a sub transform
+            std::size_t twiddles;   // offset of w^(q * j) for j in [1, radix), q in [0, length)
+            std::size_t roots;      // offset of the radix roots of unity, generic passes only
+        };
+
+        std::size_t size = 0;
+        std::vector<Pass> passes;
+        std::vector<T> twiddle_re;
+        std::vector<T> twiddle_im;
+
+        template<bool inverse>
+        void Run(const T* input_re, const T* input_im, T* output_re, T* output_im) const;
+        // same with the caller's scratch of Size() elements, it does not allocate
+        template<bool inverse>
+        void Run(const T* input_re, const T* input_im, T* output_re, T* output_im, T* scratch_re, T* scratch_im) const noexcept;
+        template<bool inverse>
+        void RunPass(const Pass& pass, const T* x_re, const T* x_im, T* y_re, T* y_im) const noexcept;
+        template<bool inverse>
+        void RunInterleaved(const Complex<T>* input, Complex<T>* output) const;
+    };
+
+    using FftD = Fft<double>;
+    using FftF = Fft<float>;
+
+    // transform of real input of even size n through a complex transform of size n / 2.
+    // the spectrum is hermitian, only its first n / 2 + 1 elements are stored
+    template<typename T>
+    struct RealFft
+    {
+        RealFft() = default;
+        // throws std::runtime_error if size is odd
+        explicit RealFft(std::size_t size);
+
+        std::size_t Size() const noexcept;
+
+        // input has Size() elements, spectrum has Size() / 2 + 1
+        void Forward(const T* input, ComplexSoA<T> spectrum) const;
+        void Forward(const T* input, Complex<T>* spectrum) const;
+        // scaled by 1 / Size()
+        void Inverse(ComplexSoA<const T> spectrum, T* output) const;
+        void Inverse(const Complex<T>* spectrum, T* output) const;
+
+    private:
+        std::size_t size = 0;
+        Fft<T> half;
+        std::vector<T> twiddle_re; // exp(-i * tau * k / size) for k in [0, size / 2]
+        std::vector<T> twiddle_im;
+    };
+
+    using RealFftD = RealFft<double>;
+    using RealFftF = RealFft<float>;
+
+    // streaming convolution of complex blocks with a fixed filter by overlap-save, y[n] = sum filter[j] * x[n - j].
+    // the filter spectrum is computed once, every block costs one forward and one inverse transform of FftSize().
+    // an output block is ready as soon as its input block is given, so the latency is BlockSize() samples.
+    // every channel owns its scratch, so blocks do not allocate on any thread. channels are independent streams sharing the plan.
+    template<typename T>
+    struct FftConvolver
+    {
+        FftConvolver() = default;
+        FftConvolver(ComplexSoA<const T> filter, std::size_t block_size, std::size_t channels = 1,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        std::size_t BlockSize() const noexcept;
+        std::size_t FilterSize() const noexcept;
+        std::size_t FftSize() const noexcept;
+        std::size_t Channels() const noexcept;
+
+        // input and output have BlockSize() elements and may be the same.
+        // different channels may be processed from different threads at once
+        void Process(ComplexSoA<const T> input, ComplexSoA<T> output, std::size_t channel = 0);
+        void Process(const Complex<T>* input, Complex<T>* output, std::size_t channel = 0);
+        // one block of every channel, channel c is [c * BlockSize(), (c + 1) * BlockSize())
+        void Process(const Execution& execution, ComplexSoA<const T> input, ComplexSoA<T> output);
+
+        // forgets the history of every channel
+        void Reset() noexcept;
+
+    private:
+        std::size_t block_size = 0;
+        std::size_t filter_size = 0;
+        std::size_t channels = 0;
+        Fft<T> fft;
+        ComplexBuffer<T> spectrum;  // of the zero padded filter
+        ComplexBuffer<T> windows;   // last FftSize() input samples of every channel, channel c starts at c * FftSize()
+        ComplexBuffer<T> scratch;   // spectrum, transform scratch and interleaved split of every channel, ScratchSize() per channel
+
+        std::size_t ScratchSize() const noexcept;
+    };
+
+    using FftConvolverD = FftConvolver<double>;
+    using FftConvolverF = FftConvolver<float>;
+
+//==============================================================================================================================================
+
+    // calculators for the MathT hooks. StdMath forwards to <cmath>
+    template<typename T>
+    struct StdMath
+    {
+        T Sqrt(const T& x) const noexcept;
+        T Exp(const T& x) const noexcept;
+        T Log(const T& x) const noexcept;
+        T Sin(const T& x) const noexcept;
+        T Cos(const T& x) const noexcept;
+        T Atan2(const T& y, const T& x) const noexcept;
+        // 1 / Sqrt(x)
+        T RSqrt(const T& x) const noexcept;
+    };
+
+    // branch free polynomials on reduced arguments, plain arithmetic so batch loops vectorize without a vector math library
+    // (gcc and clang need -fno-math-errno -fno-trapping-math to if-convert the selects).
+    // relative error about 1e-7 for float and 1e-9 for double. Sin and Cos lose accuracy above |x| ~ 1e5 and are nan
+    // above 2^30 * tau / 4 or for infinite x, Atan2 wants finite arguments.
+    // only for float and double
+    template<typename T>
+    struct FastMath
+    {
+        T Sqrt(const T& x) const noexcept;
+        T Exp(const T& x) const noexcept;
+        T Log(const T& x) const noexcept;
+        T Sin(const T& x) const noexcept;
+        T Cos(const T& x) const noexcept;
+        T Atan2(const T& y, const T& x) const noexcept;
+        // bit level first guess and newton steps, subnormal x are not supported
+        T RSqrt(const T& x) const noexcept;
+
+    private:
+        static_assert(std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8), "FastMath needs float or double");
+
+        using Bits = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+
+        static constexpr int mantissa_bits = std::numeric_limits<T>::digits - 1;
+        static constexpr int exponent_bias = std::numeric_limits<T>::max_exponent - 1;
+
+        // 2 ^ exponent for exponent in the normal range
+        static T Pow2(Bits exponent) noexcept;
+        // x - quadrant * tau / 4 in [-tau / 8, tau / 8], shared by Sin and Cos
+        static T Reduce(const T& x, Bits& quadrant) noexcept;
+        // on [-tau / 8, tau / 8]
+        static T SinPolynomial(const T& r) noexcept;
+        static T CosPolynomial(const T& r) noexcept;
+    };
+
+//==============================================================================================================================================
+
+    // calls function(std::integral_constant<std::size_t, i>()) for every i in [0, count), unrolled at compile time
+    template<std::size_t count, typename FunctionT>
+    void Unroll(FunctionT&& function);
+
+    // fixed size vector for the sizes without a hand written type. element loops are unrolled at compile time.
+    // Vector<T, 2> and Vector<T, 3> have the layout of Vector2 and Vector3, the As...() views are free
+    template<typename T, std::size_t size>
+    struct Vector
+    {
+        std::array<T, size> values = {};
+
+        T& operator[](std::size_t index) noexcept;
+        const T& operator[](std::size_t index) const noexcept;
+
+        Vector<T, size>& operator+=(const Vector<T, size>& other) noexcept;
+        Vector<T, size>& operator-=(const Vector<T, size>& other) noexcept;
+        Vector<T, size>& operator*=(const T& scalar) noexcept;
+        Vector<T, size>& operator/=(const T& scalar);
+
+        Vector<T, size> operator+(const Vector<T, size>& other) const noexcept;
+        Vector<T, size> operator-(const Vector<T, size>& other) const noexcept;
+        Vector<T, size> operator*(const T& scalar) const noexcept;
+        Vector<T, size> operator/(const T& scalar) const;
+        Vector<T, size> operator-() const noexcept;
+        // row vector times matrix, like Vector3 * Matrix3x3
+        template<std::size_t columns>
+        Vector<T, columns> operator*(const Matrix<T, size, columns>& matrix) const noexcept;
+
+        T Dot(const Vector<T, size>& other) const noexcept;
+        T Abs2() const noexcept;
+        T Abs() const noexcept;
+        // sqrt_calculator should have method "Sqrt(const T&) -> T&&"
+        template<typename MathT>
+        T Abs(MathT&& sqrt_calculator) const noexcept;
+
+        Vector<T, size>& Normalize();
+        Vector<T, size> Normalized() const;
+
+        bool operator==(const Vector<T, size>& other) const noexcept;
+        bool operator!=(const Vector<T, size>& other) const noexcept;
+        bool Compare(const Vector<T, size>& other, const T& epsilon2) const noexcept;
+
+        // only for the matching size
+        Vector2<T>& AsVector2() noexcept;
+        const Vector2<T>& AsVector2() const noexcept;
+        Vector3<T>& AsVector3() noexcept;
+        const Vector3<T>& AsVector3() const noexcept;
+        static Vector<T, size> From(const Vector2<T>& vector) noexcept;
+        static Vector<T, size> From(const Vector3<T>& vector) noexcept;
+
+        static const Vector<T, size> zero;
+        static const Vector<T, size> ones;
+    };
+
+    template<typename T>
+    using Vector4 = Vector<T, 4>;
+
+    using Vector4D = Vector4<double>;
+    using Vector4F = Vector4<float>;
+
+    // fixed size row major matrix, lines are the rows. element loops are unrolled at compile time,
+    // float 4x4 products and transpose have sse versions. Matrix<T, 2, 2> and Matrix<T, 3, 3> have the layout of Matrix2x2 and Matrix3x3
+    template<typename T, std::size_t rows, std::size_t columns>
+    struct Matrix
+    {
+        std::array<Vector<T, columns>, rows> lines = {};
+
+        Vector<T, columns>& operator[](std::size_t row) noexcept;
+        const Vector<T, columns>& operator[](std::size_t row) const noexcept;
+
+        Matrix<T, rows, columns>& operator+=(const Matrix<T, rows, columns>& other) noexcept;
+        Matrix<T, rows, columns>& operator-=(const Matrix<T, rows, columns>& other) noexcept;
+        Matrix<T, rows, columns>& operator*=(const T& scalar) noexcept;
+        Matrix<T, rows, columns>& operator/=(const T& scalar);
+
+        Matrix<T, rows, columns> operator+(const Matrix<T, rows, columns>& other) const noexcept;
+        Matrix<T, rows, columns> operator-(const Matrix<T, rows, columns>& other) const noexcept;
+        Matrix<T, rows, columns> operator*(const T& scalar) const noexcept;
+        Matrix<T, rows, columns> operator/(const T& scalar) const;
+        Matrix<T, rows, columns> operator-() const noexcept;
+        template<std::size_t other_columns>
+        Matrix<T, rows, other_columns> operator*(const Matrix<T, columns, other_columns>& other) const noexcept;
+        // matrix times column vector
+        Vector<T, rows> operator*(const Vector<T, columns>& vector) const noexcept;
+
+        bool operator==(const Matrix<T, rows, columns>& other) const noexcept;
+        bool operator!=(const Matrix<T, rows, columns>& other) const noexcept;
+        bool Compare(const Matrix<T, rows, columns>& other, const T& epsilon2) const noexcept;
+
+        Matrix<T, columns, rows> Transposed() const noexcept;
+
+        // square matrices only. closed forms up to 4x4, lu decomposition with partial pivoting beyond
+        T Det() const noexcept;
+        // throws std::runtime_error if the matrix is singular
+        Matrix<T, rows, columns> Inversed() const;
+
+        // only for the matching size
+        Matrix2x2<T>& AsMatrix2x2() noexcept;
+        const Matrix2x2<T>& AsMatrix2x2() const noexcept;
+        Matrix3x3<T>& AsMatrix3x3() noexcept;
+        const Matrix3x3<T>& AsMatrix3x3() const noexcept;
+        static Matrix<T, rows, columns> From(const Matrix2x2<T>& matrix) noexcept;
+        static Matrix<T, rows, columns> From(const Matrix3x3<T>& matrix) noexcept;
+
+        // ones on the main diagonal
+        static const Matrix<T, rows, columns> one;
+        static const Matrix<T, rows, columns> zero;
+
+    private:
+        // in place, row i of the result is row permutation[i] of the input. returns false if a pivot is zero
+        static bool Decompose(Matrix<T, rows, columns>& lu, std::array<std::size_t, rows>& permutation, T& sign) noexcept;
+    };
+
+    template<typename T>
+    using Matrix4x4 = Matrix<T, 4, 4>;
+    template<typename T>
+    using Matrix3x4 = Matrix<T, 3, 4>;
+    template<typename T>
+    using Matrix6x6 = Matrix<T, 6, 6>;
+
+    using Matrix4x4D = Matrix4x4<double>;
+    using Matrix4x4F = Matrix4x4<float>;
+    using Matrix3x4D = Matrix3x4<double>;
+    using Matrix3x4F = Matrix3x4<float>;
+    using Matrix6x6D = Matrix6x6<double>;
+    using Matrix6x6F = Matrix6x6<float>;
+
+//==============================================================================================================================================
+
+    // every prefix product of a chain of rigid transforms. link i is a rotation and an offset in the frame of link i - 1:
+    // world_rotations[i] = world_rotations[i - 1] * rotations[i],
+    // world_offsets[i] = world_offsets[i - 1] + offsets[i] rotated by world_rotations[i - 1], with the identity before link 0.
+    // the product is associative, so with an execution policy the chain is cut into blocks of Parallel::batch_grain that are scanned
+    // on their own by the threads and then moved by the product of the blocks before them, in simd lanes. the blocks are the same
+    // for every policy, so the result does not depend on the execution, it may differ from the plain overload in the last bits.
+    // rotations should be unit, they are not renormalized. outputs may be the inputs.
+    template<typename T>
+    struct ChainScan
+    {
+        static void Compose(ComplexSoA<const T> rotations, Vector2SoA<const T> offsets,
+            ComplexSoA<T> world_rotations, Vector2SoA<T> world_offsets) noexcept;
+        static void Compose(QuaternionSoA<const T> rotations, Vector3SoA<const T> offsets,
+            QuaternionSoA<T> world_rotations, Vector3SoA<T> world_offsets) noexcept;
+        static void Compose(const Execution& execution, ComplexSoA<const T> rotations, Vector2SoA<const T> offsets,
+            ComplexSoA<T> world_rotations, Vector2SoA<T> world_offsets);
+        static void Compose(const Execution& execution, QuaternionSoA<const T> rotations, Vector3SoA<const T> offsets,
+            QuaternionSoA<T> world_rotations, Vector3SoA<T> world_offsets);
+
+    private:
+        // links per tile of Apply
+        static constexpr std::size_t tile = 64;
+
+        // a * b of links stored as {re, im, x, y}
+        static std::array<T, 4> ComposeLane(const std::array<T, 4>& a, const std::array<T, 4>& b) noexcept;
+        // a * b of links stored as {re, x, y, z, offset x, offset y, offset z}
+        static std::array<T, 7> ComposeLane(const std::array<T, 7>& a, const std::array<T, 7>& b) noexcept;
+
+        template<typename PointerT, std::size_t components>
+        static std::array<T, components> Load(const std::array<PointerT, components>& data, std::size_t index) noexcept;
+        template<std::size_t components>
+        static void Store(const std::array<T*, components>& data, std::size_t index, const std::array<T, components>& link) noexcept;
+
+        // inclusive scan of [begin, begin + count)
+        template<std::size_t components>
+        static void Scan(const std::array<const T*, components>& input, const std::array<T*, components>& output,
+            std::size_t begin, std::size_t count) noexcept;
+        // output[i] = carry * output[i] for i in [begin, begin + count)
+        template<std::size_t components>
+        static void Apply(const std::array<T, components>& carry, const std::array<T*, components>& output,
+            std::size_t begin, std::size_t count) noexcept;
+        template<std::size_t components>
+        static void Scan(const Execution& execution, const std::array<const T*, components>& input, const std::array<T*, components>& output,
+            std::size_t count);
+    };
+
+//==============================================================================================================================================
+
+    // particle steps over SoA positions, for cloth, hair and effects. gravity and accelerations are in units per second^2.
+    // damping is the part of the velocity removed per second, the velocity is scaled by max(0, 1 - damping * dt) every step.
+    // accelerations may be empty (size 0), otherwise they have positions.size elements
+    template<typename T>
+    struct Particles
+    {
+        // v = (v + (gravity + a) * dt) * keep, then p += v * dt
+        static void SemiImplicitEuler(Vector2SoA<T> positions, Vector2SoA<T> velocities, Vector2SoA<const T> accelerations,
+            const Vector2<T>& gravity, const T& damping, const T& dt) noexcept;
+        static void SemiImplicitEuler(Vector3SoA<T> positions, Vector3SoA<T> velocities, Vector3SoA<const T> accelerations,
+            const Vector3<T>& gravity, const T& damping, const T& dt) noexcept;
+        static void SemiImplicitEuler(const Execution& execution, Vector2SoA<T> positions, Vector2SoA<T> velocities, Vector2SoA<const T> accelerations,
+            const Vector2<T>& gravity, const T& damping, const T& dt);
+        static void SemiImplicitEuler(const Execution& execution, Vector3SoA<T> positions, Vector3SoA<T> velocities, Vector3SoA<const T> accelerations,
+            const Vector3<T>& gravity, const T& damping, const T& dt);
+
+        // position verlet, the velocity is (positions - previous_positions) / dt:
+        // p' = p + (p - previous) * keep + (gravity + a) * dt^2, previous' = p
+        static void Verlet(Vector2SoA<T> positions, Vector2SoA<T> previous_positions, Vector2SoA<const T> accelerations,
+            const Vector2<T>& gravity, const T& damping, const T& dt) noexcept;
+        static void Verlet(Vector3SoA<T> positions, Vector3SoA<T> previous_positions, Vector3SoA<const T> accelerations,
+            const Vector3<T>& gravity, const T& damping, const T& dt) noexcept;
+        static void Verlet(const Execution& execution, Vector2SoA<T> positions, Vector2SoA<T> previous_positions, Vector2SoA<const T> accelerations,
+            const Vector2<T>& gravity, const T& damping, const T& dt);
+        static void Verlet(const Execution& execution, Vector3SoA<T> positions, Vector3SoA<T> previous_positions, Vector3SoA<const T> accelerations,
+            const Vector3<T>& gravity, const T& damping, const T& dt);
+
+        // one gauss seidel sweep of distance constraints: constraint i pulls particles first[i] and second[i] towards rest_lengths[i],
+        // split by the inverse masses (0 pins a particle). stiffness in [0, 1] is the part of the error removed per sweep
+        static void ProjectDistances(Vector2SoA<T> positions, const T* inverse_masses,
+            const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t count, const T& stiffness) noexcept;
+        static void ProjectDistances(Vector3SoA<T> positions, const T* inverse_masses,
+            const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t count, const T& stiffness) noexcept;
+        // same sweep over constraints ordered by ColorConstraints. colors are visited in order, the constraints of one color share
+        // no particle, so they are split between the threads and projected in simd lanes
+        static void ProjectDistances(const Execution& execution, Vector2SoA<T> positions, const T* inverse_masses,
+            const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, const std::vector<std::size_t>& colors, const T& stiffness);
+        static void ProjectDistances(const Execution& execution, Vector3SoA<T> positions, const T* inverse_masses,
+            const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, const std::vector<std::size_t>& colors, const T& stiffness);
+
+        // greedy coloring: reorders the constraints in place so that every color is contiguous and no two constraints of a color
+        // share a particle. returns the offsets of the colors, the last one is count. the order inside a color is kept.
+        // a pair out of [0, particle_count) or of one particle throws
+        static std::vector<std::size_t> ColorConstraints(std::uint32_t* first, std::uint32_t* second, T* rest_lengths, std::size_t count,
+            std::size_t particle_count);
+
+    private:
+        // constraints per tile of ProjectIndependent
+        static constexpr std::size_t tile = 64;
+
+        template<std::size_t dimensions>
+        static void SemiImplicitEuler(const std::array<T*, dimensions>& positions, const std::array<T*, dimensions>& velocities,
+            const std::array<const T*, dimensions>& accelerations, const std::array<T, dimensions>& gravity,
+            const T& damping, const T& dt, std::size_t count) noexcept;
+        template<std::size_t dimensions>
+        static void Verlet(const std::array<T*, dimensions>& positions, const std::array<T*, dimensions>& previous_positions,
+            const std::array<const T*, dimensions>& accelerations, const std::array<T, dimensions>& gravity,
+            const T& damping, const T& dt, std::size_t count) noexcept;
+
+        // scale of the correction along second - first, zero for coincident or pinned pairs
+        static T CorrectionLane(const T& length2, const T& rest_length, const T& inverse_mass_sum, const T& stiffness) noexcept;
+        template<std::size_t dimensions>
+        static void ProjectDistances(const std::array<T*, dimensions>& positions, const T* inverse_masses,
+            const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t count, const T& stiffness) noexcept;
+        // constraints in [begin, end) share no particle
+        template<std::size_t dimensions>
+        static void ProjectIndependent(const std::array<T*, dimensions>& positions, const T* inverse_masses,
+            const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t begin, std::size_t end,
+            const T& stiffness) noexcept;
+        template<std::size_t dimensions>
+        static void ProjectDistances(const Execution& execution, const std::array<T*, dimensions>& positions, const T* inverse_masses,
+            const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, const std::vector<std::size_t>& colors, const T& stiffness);
+    };
+
+//==============================================================================================================================================
+
+    // per vertex attributes of an indexed triangle mesh, triangle t has the vertices indices[3 * t], indices[3 * t + 1], indices[3 * t + 2]
+    // in counter clockwise order. the sequential functions add the faces into their vertices, the Execution overloads compute the faces
+    // first and let every vertex gather its own faces through VertexFaces, so there is no race and the sums are in the same order
+    template<typename T>
+    struct MeshAttributes
+    {
+        // vertex to face adjacency, built once per topology.
+        // the faces of vertex v are faces[offsets[v]] ... faces[offsets[v + 1] - 1] in ascending order
+        struct VertexFaces
+        {
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::uint32_t> faces;
+
+            VertexFaces() = default;
+            // an index out of [0, vertex_count) throws
+            VertexFaces(const std::uint32_t* indices, std::size_t triangle_count, std::size_t vertex_count);
+
+            std::size_t VertexCount() const noexcept;
+            std::size_t TriangleCount() const noexcept;
+        };
+
+        // (b - a).Cross(c - a), its length is twice the area. face_normals.size triangles
+        static void FaceNormals(Vector3SoA<const T> positions, const std::uint32_t* indices, Vector3SoA<T> face_normals) noexcept;
+        static void FaceNormals(const Execution& execution, Vector3SoA<const T> positions, const std::uint32_t* indices, Vector3SoA<T> face_normals);
+
+        // area weighted sum of the face normals, normalized. normals.size vertices, vertices without area get zero
+        static void VertexNormals(Vector3SoA<const T> positions, const std::uint32_t* indices, std::size_t triangle_count,
+            Vector3SoA<T> normals) noexcept;
+        static void VertexNormals(const Execution& execution, Vector3SoA<const T> positions, const std::uint32_t* indices,
+            const VertexFaces& vertex_faces, Vector3SoA<T> normals);
+
+        // tangents along increasing u, from the sum of the per face directions of Lengyel's method, made orthogonal to the unit normals
+        // and normalized. handedness is +1 or -1, the sign of the bitangent against normal.Cross(tangent), voted by the faces.
+        // vertices without a usable uv mapping get some tangent orthogonal to the normal, vertices with a zero normal get zero
+        static void Tangents(Vector3SoA<const T> positions, Vector2SoA<const T> uvs, const std::uint32_t* indices, std::size_t triangle_count,
+            Vector3SoA<const T> normals, Vector3SoA<T> tangents, T* handedness) noexcept;
+        static void Tangents(const Execution& execution, Vector3SoA<const T> positions, Vector2SoA<const T> uvs, const std::uint32_t* indices,
+            const VertexFaces& vertex_faces, Vector3SoA<const T> normals, Vector3SoA<T> tangents, T* handedness);
+
+        // compressed unit vectors: octahedral mapping, two snorm16 per direction, error below 1e-4 rad.
+        // directions are normalized on decoding, the zero vector decodes as (0, 0, 1)
+        static void EncodeOctahedral(Vector3SoA<const T> directions, std::int16_t* u, std::int16_t* v) noexcept;
+        static void DecodeOctahedral(const std::int16_t* u, const std::int16_t* v, Vector3SoA<T> directions) noexcept;
+        static void EncodeOctahedral(const Execution& execution, Vector3SoA<const T> directions, std::int16_t* u, std::int16_t* v);
+        static void DecodeOctahedral(const Execution& execution, const std::int16_t* u, const std::int16_t* v, Vector3SoA<T> directions);
+
+    private:
+        // (b - a).Cross(c - a) of one face
+        static void FaceNormalLane(const Vector3SoA<const T>& positions, std::uint32_t a, std::uint32_t b, std::uint32_t c,
+            T& x, T& y, T& z) noexcept;
+        // unnormalized tangent and bitangent of one face, zero for a degenerate uv mapping
+        static void FaceTangentLane(
+            const T& ax, const T& ay, const T& az, const T& bx, const T& by, const T& bz, const T& cx, const T& cy, const T& cz,
+            const T& au, const T& av, const T& bu, const T& bv, const T& cu, const T& cv,
+            T& tx, T& ty, T& tz, T& sx, T& sy, T& sz) noexcept;
+        // normal.Cross(tangent).Dot(bitangent), the vote of one face for the handedness
+        static T OrientationLane(const T& nx, const T& ny, const T& nz, const T& tx, const T& ty, const T& tz,
+            const T& sx, const T& sy, const T& sz) noexcept;
+        static void NormalizeLane(T& x, T& y, T& z) noexcept;
+        // tangent minus its part along the normal, normalized, handedness from the vote
+        static void FrameLane(const T& nx, const T& ny, const T& nz, T& tx, T& ty, T& tz, T& handedness) noexcept;
+        static void EncodeLane(const T& x, const T& y, const T& z, std::int16_t& u, std::int16_t& v) noexcept;
+        static void DecodeLane(const std::int16_t& u, const std::int16_t& v, T& x, T& y, T& z) noexcept;
+    };
+
+//==============================================================================================================================================
+
+    // z range of the clip space of a projection
+    enum class DepthRange
+    {
+        negative_one_to_one,    // opengl
+        zero_to_one             // direct3d, vulkan, metal
+    };
+
+    // points with normal.Dot(point) + distance == 0, the normal points to the positive side
+    template<typename T>
+    struct Plane3
+    {
+        Vector3<T> normal = { 0, 0, 1 };
+        T distance = {0};
+
+        // signed distance for a unit normal, scaled by the normal length otherwise
+        T Distance(const Vector3<T>& point) const noexcept;
+        // a zero normal gives the plane (0, 0, 0, 1), everything is on its positive side
+        Plane3<T> Normalized() const noexcept;
+
+        static Plane3<T> FromPointNormal(const Vector3<T>& point, const Vector3<T>& normal) noexcept;
+        // a, b, c counter clockwise seen from the positive side, the normal is not normalized
+        static Plane3<T> FromPoints(const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& c) noexcept;
+    };
+
+    using Plane3D = Plane3<double>;
+    using Plane3F = Plane3<float>;
+
+    // six planes with unit normals pointing inside. the tests are conservative, a volume is rejected only when it is entirely
+    // on the negative side of one plane. batch results are bitmasks: bit i % 64 of visible[i / 64] is set for a visible object,
+    // (count + 63) / 64 words are written. the objects of a word are tested in simd lanes, float uses 8 wide avx when it is enabled
+    template<typename T>
+    struct Frustum
+    {
+        // left, right, bottom, top, near, far
+        std::array<Plane3<T>, 6> planes;
+
+        // planes of the clip volume of a view projection transform, points are row vectors [x y z 1] * transform
+        // like the transforms of Matrix3x3::MakeTransform3D. an infinite far plane gives a plane that rejects nothing
+        static Frustum<T> FromTransform(const Transform3dUniform<T>& view_projection, DepthRange depth = DepthRange::zero_to_one) noexcept;
+
+        bool IntersectsSphere(const Vector3<T>& center, const T& radius) const noexcept;
+        bool IntersectsBox(const Vector3<T>& lower, const Vector3<T>& upper) const noexcept;
+
+        // radii and every view have the same size
+        void CullSpheres(Vector3SoA<const T> centers, const T* radii, std::uint64_t* visible) const noexcept;
+        void CullBoxes(Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint64_t* visible) const noexcept;
+        // coherence hints, one per object: the plane that rejected the object last time is tested first and hints are updated
+        // with the rejecting plane. a word whose objects are all rejected by their hints skips the other planes. start with zeros
+        void CullSpheres(Vector3SoA<const T> centers, const T* radii, std::uint8_t* hints, std::uint64_t* visible) const noexcept;
+        void CullBoxes(Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint8_t* hints, std::uint64_t* visible) const noexcept;
+        void CullSpheres(const Execution& execution, Vector3SoA<const T> centers, const T* radii, std::uint64_t* visible) const;
+        void CullBoxes(const Execution& execution, Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint64_t* visible) const;
+        void CullSpheres(const Execution& execution, Vector3SoA<const T> centers, const T* radii, std::uint8_t* hints, std::uint64_t* visible) const;
+        void CullBoxes(const Execution& execution, Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint8_t* hints,
+            std::uint64_t* visible) const;
+
+    private:
+        // objects per word of the bitmask
+        static constexpr std::size_t word = 64;
+
+        // object l is entirely behind plane p
+        bool SphereOutside(std::size_t p, const T* x, const T* y, const T* z, const T* r, std::size_t l) const noexcept;
+        bool BoxOutside(std::size_t p, const T* lx, const T* ly, const T* lz, const T* ux, const T* uy, const T* uz, std::size_t l) const noexcept;
+        // bit l is set for the visible objects among count <= word ones
+        std::uint64_t SphereWord(const T* x, const T* y, const T* z, const T* r, std::size_t count) const noexcept;
+        std::uint64_t BoxWord(const T* lx, const T* ly, const T* lz, const T* ux, const T* uy, const T* uz, std::size_t count) const noexcept;
+        // bit l is set for the objects entirely behind plane hints[l], hints out of range are reset to 0
+        std::uint64_t SphereHintWord(const T* x, const T* y, const T* z, const T* r, std::uint8_t* hints, std::size_t count) const noexcept;
+        std::uint64_t BoxHintWord(const T* lx, const T* ly, const T* lz, const T* ux, const T* uy, const T* uz, std::uint8_t* hints,
+            std::size_t count) const noexcept;
+        // bit l is lanes[l], the lanes are 0 or 1
+        static std::uint64_t Pack(const std::uint8_t (&lanes)[word]) noexcept;
+        // hints of the rejected objects that their hint did not reject move to the first rejecting plane
+        template<typename OutsideT>
+        static void UpdateHints(OutsideT&& outside, std::uint64_t visible, std::uint64_t hint_rejected, std::uint8_t* hints, std::size_t count) noexcept;
+    };
+
+    using FrustumD = Frustum<double>;
+    using FrustumF = Frustum<float>;
+
+//==============================================================================================================================================
+
+    // polygons are closed loops of vertices without the repeated first vertex, counterclockwise loops have positive area.
+    // many small polygons are stored back to back, polygon i is vertices offsets[i] ... offsets[i + 1] - 1.
+    // T should be a floating point type.
+    template<typename T>
+    struct Polygon2
+    {
+        // indices of the hull vertices in counterclockwise order, starting at the lowest x (then lowest y).
+        // collinear points are not vertices, of equal points only the lowest index is used.
+        // points inside the octagon of the 8 extreme points are dropped before the hull is built,
+        // the rest is split in blocks whose hulls are merged, so the result does not depend on the execution.
+        // more than 2^32 - 1 points throw
+        static std::vector<std::uint32_t> ConvexHull(Vector2SoA<const T> points, const Execution& execution = Execution());
+
+        // signed area, positive for counterclockwise loops
+        static T Area(Vector2SoA<const T> polygon) noexcept;
+        // center of the area, the mean of the vertices if the area is zero
+        static Vector2<T> Centroid(Vector2SoA<const T> polygon) noexcept;
+
+        // areas[i] and centroids[i] of count polygons
+        static void Areas(Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count, T* areas) noexcept;
+        static void Centroids(Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count, Vector2SoA<T> centroids) noexcept;
+        static void Areas(const Execution& execution, Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count, T* areas);
+        static void Centroids(const Execution& execution, Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count,
+            Vector2SoA<T> centroids);
+
+    private:
+        static constexpr std::size_t block_size = std::size_t{1} << 16;
+        static constexpr std::size_t lanes = 8;
+
+        // (x, y) projected on the 8 directions of 45 degree steps, counterclockwise from +x
+        static std::array<T, 8> Projections(const T& x, const T& y) noexcept;
+        // first index of the maximum of every projection, plus offset
+        static std::array<std::uint32_t, 8> Extremes(Vector2SoA<const T> points, std::size_t offset) noexcept;
+        // keep[i] is 0 if points[i] is strictly inside the octagon
+        static void Filter(Vector2SoA<const T> points, const std::array<Vector2<T>, 8>& octagon, std::uint8_t* keep) noexcept;
+        // monotone chain over the given indices, which get sorted
+        static std::vector<std::uint32_t> Chain(Vector2SoA<const T> points, std::vector<std::uint32_t> indices);
+        // sums of (a - origin).OrthogonalL().Dot(b - origin) over the edges, and of the same weighted by a + b - 2 * origin
+        static T DoubleArea(Vector2SoA<const T> polygon) noexcept;
+        static T DoubleArea(Vector2SoA<const T> polygon, Vector2<T>& moment) noexcept;
+    };
+
+    using Polygon2D = Polygon2<double>;
+    using Polygon2F = Polygon2<float>;
+
+//==============================================================================================================================================
+
+    // vertex welding with the semantics of a pairwise Compare search: going through the points in order, a point is merged into
+    // the first kept point before it that Compares equal, otherwise it is kept. points are hashed into a grid of cells four times
+    // the epsilon wide, so a point searches its own cell and the neighbors on the sides it is close to. the search runs in parallel,
+    // the result does not depend on the execution
+    template<typename T>
+    struct Weld3
+    {
+        // remap[i] is the lowest j <= i with remap[j] == j and points[j].Compare(points[i], epsilon2), remap[i] == i for kept points.
+        // epsilon2 <= 0 keeps every point. more than 2^32 - 1 points, NaN, or coordinates too far from zero for the epsilon throw
+        static std::vector<std::uint32_t> Remap(Vector3SoA<const T> points, const T& epsilon2, const Execution& execution = Execution());
+
+        // turns remap into indices of the kept points in their order and returns the original index of every kept point
+        static std::vector<std::uint32_t> Compact(std::vector<std::uint32_t>& remap);
+
+    private:
+        // open addressing hash of the occupied cells, the points of cell c are members[offsets[c]] ... members[offsets[c + 1] - 1]
+        // in ascending order
+        struct Grid
+        {
+            struct Entry
+            {
+                Vector3I cell;
+                // c + 1, zero for an empty slot
+                std::uint32_t id = 0;
+            };
+
+            std::vector<Entry> table;
+            std::vector<Vector3I> cells;
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::uint32_t> members;
+            // cell of every point
+            std::vector<std::uint32_t> point_cells;
+
+            // slot of the cell, or the empty slot where it would be inserted
+            std::size_t Slot(const Vector3I& cell) const noexcept;
+        };
+
+        // floor(point * inverse + 0.5), components out of [-limit, limit] or NaN are INT_MIN
+        static Vector3I Cell(const T& x, const T& y, const T& z, const T& inverse, const T& limit) noexcept;
+        // lowest j < i in the cells around i that Compares equal and is accepted, i if there is none
+        template<typename AcceptT>
+        static std::uint32_t First(const Grid& grid, Vector3SoA<const T> points, const T& epsilon2, const T& inverse, std::uint32_t i,
+            AcceptT&& accept) noexcept;
+    };
+
+    using Weld3D = Weld3<double>;
+    using Weld3F = Weld3<float>;
+
 }
 
 //==============================================================================================================================================
@@ -590,3 +2502,23 @@ namespace linal // structures declarations
 #include "Linal_Direction3_Definitions.h"
 #include "Linal_Rotator3_Definitions.h"
 #include "Linal_RotMatrix3x3_Definitions.h"
+
+#include "Linal_SoA_Definitions.h"
+#include "Linal_FrameArena_Definitions.h"
+#include "Linal_ArrayFile_Definitions.h"
+#include "Linal_Parallel_Definitions.h"
+#include "Linal_Intersection2_Definitions.h"
+#include "Linal_BinaryAngle_Definitions.h"
+#include "Linal_KdTree3_Definitions.h"
+#include "Linal_PointStatistics3_Definitions.h"
+#include "Linal_AnimationClip_Definitions.h"
+#include "Linal_CubicCurve_Definitions.h"
+#include "Linal_Fft_Definitions.h"
+#include "Linal_Math_Definitions.h"
+#include "Linal_MatrixN_Definitions.h"
+#include "Linal_ChainScan_Definitions.h"
+#include "Linal_Particles_Definitions.h"
+#include "Linal_MeshAttributes_Definitions.h"
+#include "Linal_Frustum_Definitions.h"
+#include "Linal_Polygon2_Definitions.h"
+#include "Linal_Weld3_Definitions.h"
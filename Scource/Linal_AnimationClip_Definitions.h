@@ -0,0 +1,290 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cmath>
+
+namespace linal
+{
+    template<typename T>
+    AnimationClip<T>::AnimationClip(QuaternionSoA<const T> rotation_keys, std::size_t rotation_tracks,
+        Vector3SoA<const T> vector_keys, std::size_t vector_tracks,
+        std::size_t frame_count, const T& frame_rate, std::size_t segment_frames)
+        : rotation_tracks(rotation_tracks), vector_tracks(vector_tracks), frame_count(frame_count),
+        segment_frames(std::max<std::size_t>(segment_frames, 1)), frame_rate(frame_rate)
+    {
+        if(frame_count == 0 || !(frame_rate > 0))
+        {
+            throw std::runtime_error("animation clip needs at least one frame and a positive frame rate");
+        }
+        if(rotation_keys.size < frame_count * rotation_tracks || vector_keys.size < frame_count * vector_tracks)
+        {
+            throw std::runtime_error("not enough keys for animation clip");
+        }
+
+        const std::size_t segments = frame_count > 1 ? (frame_count - 2) / this->segment_frames + 1 : 1;
+        const std::size_t keys = this->segment_frames + 1;
+        const std::size_t R = rotation_tracks;
+        const std::size_t V = vector_tracks;
+
+        // neighbouring rotation keys get the same hemisphere, so nlerp takes the short way
+        std::vector<signed char> signs(frame_count * R, 1);
+        for(std::size_t t = 0; t < R; ++t)
+        {
+            for(std::size_t f = 1; f < frame_count; ++f)
+            {
+                std::size_t a = (f - 1) * R + t;
+                std::size_t b = f * R + t;
+                T dot = rotation_keys.re[a] * rotation_keys.re[b] + rotation_keys.x[a] * rotation_keys.x[b] +
+                    rotation_keys.y[a] * rotation_keys.y[b] + rotation_keys.z[a] * rotation_keys.z[b];
+                signs[b] = dot < 0 ? -signs[a] : signs[a];
+            }
+        }
+
+        rotation_data.resize(segments * keys * 4 * R);
+        vector_data.resize(segments * keys * 3 * V);
+        vector_ranges.resize(segments * 2 * 3 * V);
+        for(std::size_t s = 0; s < segments; ++s)
+        {
+            for(std::size_t k = 0; k < keys; ++k)
+            {
+                const std::size_t f = std::min(s * this->segment_frames + k, frame_count - 1);
+                std::int16_t* out = rotation_data.data() + (s * keys + k) * 4 * R;
+                for(std::size_t t = 0; t < R; ++t)
+                {
+                    const std::size_t i = f * R + t;
+                    T q[4] = { rotation_keys.re[i], rotation_keys.x[i], rotation_keys.y[i], rotation_keys.z[i] };
+                    T length2 = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+                    T scale = signs[i] * T(32767) / std::sqrt(length2 > 0 ? length2 : T(1));
+                    for(std::size_t c = 0; c < 4; ++c)
+                    {
+                        out[c * R + t] = static_cast<std::int16_t>(std::lround(std::clamp(q[c] * scale, T(-32767), T(32767))));
+                    }
+                }
+            }
+
+            T* range = vector_ranges.data() + s * 2 * 3 * V;
+            for(std::size_t t = 0; t < V; ++t)
+            {
+                for(std::size_t c = 0; c < 3; ++c)
+                {
+                    const T* source = c == 0 ? vector_keys.x : c == 1 ? vector_keys.y : vector_keys.z;
+                    T lower = std::numeric_limits<T>::max();
+                    T upper = std::numeric_limits<T>::lowest();
+                    for(std::size_t k = 0; k < keys; ++k)
+                    {
+                        const T value = source[std::min(s * this->segment_frames + k, frame_count - 1) * V + t];
+                        lower = std::min(lower, value);
+                        upper = std::max(upper, value);
+                    }
+                    const T step = (upper - lower) / T(65535);
+                    range[c * V + t] = lower;
+                    range[(3 + c) * V + t] = step;
+                    for(std::size_t k = 0; k < keys; ++k)
+                    {
+                        const T value = source[std::min(s * this->segment_frames + k, frame_count - 1) * V + t];
+                        const T units = step > 0 ? (value - lower) / step : T(0);
+                        vector_data[((s * keys + k) * 3 + c) * V + t] = static_cast<std::uint16_t>(std::lround(std::clamp(units, T(0), T(65535))));
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    std::size_t AnimationClip<T>::RotationTracks() const noexcept
+    {
+        return rotation_tracks;
+    }
+
+    template<typename T>
+    std::size_t AnimationClip<T>::VectorTracks() const noexcept
+    {
+        return vector_tracks;
+    }
+
+    template<typename T>
+    std::size_t AnimationClip<T>::FrameCount() const noexcept
+    {
+        return frame_count;
+    }
+
+    template<typename T>
+    T AnimationClip<T>::Duration() const noexcept
+    {
+        return frame_count > 1 ? T(frame_count - 1) / frame_rate : T(0);
+    }
+
+    template<typename T>
+    void AnimationClip<T>::Sample(const T& time, QuaternionSoA<T> rotations, Vector3SoA<T> vectors) const noexcept
+    {
+        std::size_t frame;
+        T alpha;
+        Locate(time, frame, alpha);
+
+        const std::size_t R = rotation_tracks;
+        const std::int16_t* rotation = RotationKey(frame);
+        const std::int16_t* rotation_a[4] = { rotation, rotation + R, rotation + 2 * R, rotation + 3 * R };
+        const std::int16_t* rotation_b[4] = { rotation + 4 * R, rotation + 5 * R, rotation + 6 * R, rotation + 7 * R };
+        BlendRotations(rotation_a, rotation_b, alpha, { rotations.re, rotations.x, rotations.y, rotations.z, R });
+
+        const std::size_t V = vector_tracks;
+        const std::uint16_t* vector = VectorKey(frame);
+        const std::uint16_t* vector_a[3] = { vector, vector + V, vector + 2 * V };
+        const std::uint16_t* vector_b[3] = { vector + 3 * V, vector + 4 * V, vector + 5 * V };
+        BlendVectors(vector_a, vector_b, VectorRange(frame), alpha, { vectors.x, vectors.y, vectors.z, V });
+    }
+
+    template<typename T>
+    void AnimationClip<T>::Locate(const T& time, std::size_t& frame, T& alpha) const noexcept
+    {
+        if(frame_count < 2)
+        {
+            frame = 0;
+            alpha = 0;
+            return;
+        }
+        T position = time * frame_rate;
+        position = position > 0 ? std::min(position, T(frame_count - 1)) : T(0);
+        frame = std::min(static_cast<std::size_t>(position), frame_count - 2);
+        alpha = position - T(frame);
+    }
+
+    template<typename T>
+    const std::int16_t* AnimationClip<T>::RotationKey(std::size_t frame) const noexcept
+    {
+        const std::size_t segment = frame / segment_frames;
+        return rotation_data.data() + (segment * (segment_frames + 1) + frame % segment_frames) * 4 * rotation_tracks;
+    }
+
+    template<typename T>
+    const std::uint16_t* AnimationClip<T>::VectorKey(std::size_t frame) const noexcept
+    {
+        const std::size_t segment = frame / segment_frames;
+        return vector_data.data() + (segment * (segment_frames + 1) + frame % segment_frames) * 3 * vector_tracks;
+    }
+
+    template<typename T>
+    const T* AnimationClip<T>::VectorRange(std::size_t frame) const noexcept
+    {
+        return vector_ranges.data() + frame / segment_frames * 2 * 3 * vector_tracks;
+    }
+
+    template<typename T>
+    template<typename KeyT>
+    void AnimationClip<T>::BlendRotations(const KeyT* const* a, const KeyT* const* b, const T& alpha, QuaternionSoA<T> rotations) noexcept
+    {
+        const KeyT* a0 = a[0];
+        const KeyT* a1 = a[1];
+        const KeyT* a2 = a[2];
+        const KeyT* a3 = a[3];
+        const KeyT* b0 = b[0];
+        const KeyT* b1 = b[1];
+        const KeyT* b2 = b[2];
+        const KeyT* b3 = b[3];
+        for(std::size_t t = 0; t < rotations.size; ++t)
+        {
+            const T re = T(a0[t]) + (T(b0[t]) - T(a0[t])) * alpha;
+            const T x = T(a1[t]) + (T(b1[t]) - T(a1[t])) * alpha;
+            const T y = T(a2[t]) + (T(b2[t]) - T(a2[t])) * alpha;
+            const T z = T(a3[t]) + (T(b3[t]) - T(a3[t])) * alpha;
+            const T length2 = re * re + x * x + y * y + z * z;
+            const T inv = T(1) / std::sqrt(length2 > 0 ? length2 : T(1));
+            rotations.re[t] = re * inv;
+            rotations.x[t] = x * inv;
+            rotations.y[t] = y * inv;
+            rotations.z[t] = z * inv;
+        }
+    }
+
+    template<typename T>
+    template<typename KeyT>
+    void AnimationClip<T>::BlendVectors(const KeyT* const* a, const KeyT* const* b, const T* range, const T& alpha, Vector3SoA<T> vectors) noexcept
+    {
+        const std::size_t V = vectors.size;
+        T* out[3] = { vectors.x, vectors.y, vectors.z };
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            const KeyT* ac = a[c];
+            const KeyT* bc = b[c];
+            const T* lower = range + c * V;
+            const T* step = range + (3 + c) * V;
+            T* result = out[c];
+            for(std::size_t t = 0; t < V; ++t)
+            {
+                result[t] = lower[t] + step[t] * (T(ac[t]) + (T(bc[t]) - T(ac[t])) * alpha);
+            }
+        }
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    AnimationClip<T>::Cursor::Cursor(const AnimationClip<T>& clip, std::pmr::memory_resource* resource)
+        : clip(&clip),
+        rotation_keys{ QuaternionBuffer<T>(clip.rotation_tracks, resource), QuaternionBuffer<T>(clip.rotation_tracks, resource) },
+        vector_keys{ Vector3Buffer<T>(clip.vector_tracks, resource), Vector3Buffer<T>(clip.vector_tracks, resource) }
+    {}
+
+    template<typename T>
+    void AnimationClip<T>::Cursor::Sample(const T& time, QuaternionSoA<T> rotations, Vector3SoA<T> vectors)
+    {
+        std::size_t next;
+        T alpha;
+        clip->Locate(time, next, alpha);
+
+        if(next != frame)
+        {
+            // the second key is reused only inside a segment, a new segment quantizes vectors with another range
+            if(next == frame + 1 && next % clip->segment_frames != 0)
+            {
+                current ^= 1;
+                Decode(current ^ 1, next, 1);
+            }
+            else
+            {
+                Decode(current, next, 0);
+                Decode(current ^ 1, next, 1);
+            }
+            frame = next;
+        }
+
+        const QuaternionBuffer<T>& ra = rotation_keys[current];
+        const QuaternionBuffer<T>& rb = rotation_keys[current ^ 1];
+        const T* rotation_a[4] = { ra.Component(0), ra.Component(1), ra.Component(2), ra.Component(3) };
+        const T* rotation_b[4] = { rb.Component(0), rb.Component(1), rb.Component(2), rb.Component(3) };
+        BlendRotations(rotation_a, rotation_b, alpha, { rotations.re, rotations.x, rotations.y, rotations.z, clip->rotation_tracks });
+
+        const Vector3Buffer<T>& va = vector_keys[current];
+        const Vector3Buffer<T>& vb = vector_keys[current ^ 1];
+        const T* vector_a[3] = { va.Component(0), va.Component(1), va.Component(2) };
+        const T* vector_b[3] = { vb.Component(0), vb.Component(1), vb.Component(2) };
+        BlendVectors(vector_a, vector_b, clip->VectorRange(frame), alpha, { vectors.x, vectors.y, vectors.z, clip->vector_tracks });
+    }
+
+    template<typename T>
+    void AnimationClip<T>::Cursor::Decode(std::size_t slot, std::size_t frame, std::size_t offset) noexcept
+    {
+        // keys stay in quantized units, the blend is the same as in AnimationClip::Sample
+        const std::size_t R = clip->rotation_tracks;
+        const std::int16_t* rotation = clip->RotationKey(frame) + offset * 4 * R;
+        for(std::size_t c = 0; c < 4; ++c)
+        {
+            T* out = rotation_keys[slot].Component(c);
+            for(std::size_t t = 0; t < R; ++t)
+            {
+                out[t] = T(rotation[c * R + t]);
+            }
+        }
+
+        const std::size_t V = clip->vector_tracks;
+        const std::uint16_t* vector = clip->VectorKey(frame) + offset * 3 * V;
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            T* out = vector_keys[slot].Component(c);
+            for(std::size_t t = 0; t < V; ++t)
+            {
+                out[t] = T(vector[c * V + t]);
+            }
+        }
+    }
+} // namespace linal
@@ -0,0 +1,471 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace linal
+{
+    template<typename T>
+    struct ArrayFile::Traits<Vector2<T>>
+    {
+        using Scalar = T;
+        static constexpr ArrayElement element = ArrayElement::vector2;
+        static constexpr std::size_t components = 2;
+    };
+
+    template<typename T>
+    struct ArrayFile::Traits<Complex<T>>
+    {
+        using Scalar = T;
+        static constexpr ArrayElement element = ArrayElement::complex;
+        static constexpr std::size_t components = 2;
+    };
+
+    template<typename T>
+    struct ArrayFile::Traits<Vector3<T>>
+    {
+        using Scalar = T;
+        static constexpr ArrayElement element = ArrayElement::vector3;
+        static constexpr std::size_t components = 3;
+    };
+
+    template<typename T>
+    struct ArrayFile::Traits<Quaternion<T>>
+    {
+        using Scalar = T;
+        static constexpr ArrayElement element = ArrayElement::quaternion;
+        static constexpr std::size_t components = 4;
+    };
+
+    inline ArrayFile::ArrayFile(ArrayFile&& other) noexcept
+        : storage(std::move(other.storage)), image(other.image), image_size(other.image_size), header(other.header)
+    {
+        other.image = nullptr;
+        other.image_size = 0;
+        other.header = {};
+    }
+
+    inline ArrayFile& ArrayFile::operator=(ArrayFile&& other) noexcept
+    {
+        std::swap(storage, other.storage);
+        std::swap(image, other.image);
+        std::swap(image_size, other.image_size);
+        std::swap(header, other.header);
+        return *this;
+    }
+
+    inline ArrayFile::~ArrayFile()
+    {
+        Unmap();
+    }
+
+    inline ArrayFile::ArrayFile(const std::string& path)
+    {
+#if defined(_WIN32)
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if(!file)
+        {
+            throw std::runtime_error("can not open array file " + path);
+        }
+        storage.Resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        if(!file.read(reinterpret_cast<char*>(storage.Component(0)), static_cast<std::streamsize>(storage.Size())))
+        {
+            throw std::runtime_error("can not read array file " + path);
+        }
+        image = storage.Component(0);
+        image_size = storage.Size();
+#else
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if(descriptor < 0)
+        {
+            throw std::runtime_error("can not open array file " + path);
+        }
+        struct stat status;
+        if(fstat(descriptor, &status) != 0)
+        {
+            close(descriptor);
+            throw std::runtime_error("can not read array file " + path);
+        }
+        image_size = static_cast<std::size_t>(status.st_size);
+        void* mapping = image_size ? mmap(nullptr, image_size, PROT_READ, MAP_PRIVATE, descriptor, 0) : MAP_FAILED;
+        close(descriptor); // the mapping keeps the file open
+        if(mapping == MAP_FAILED)
+        {
+            image_size = 0;
+            throw std::runtime_error("can not map array file " + path);
+        }
+        image = static_cast<const unsigned char*>(mapping);
+#endif
+
+        if(image_size < sizeof(Header))
+        {
+            Unmap();
+            throw std::runtime_error("array file is too small");
+        }
+        std::memcpy(&header, image, sizeof(Header));
+
+        const char* error = nullptr;
+        std::uint32_t element = header.element;
+        std::size_t components = element == 3 ? 3 : element == 4 ? 4 : 2;
+        if(std::memcmp(header.magic, "LARR", 4) != 0 || header.version != version)
+        {
+            error = "not an array file";
+        }
+        else if(element < 1 || element > 4 || header.components != components || header.layout > 1 ||
+            header.scalar_kind > 2 || header.scalar_size == 0 || header.scalar_size > 16 ||
+            header.alignment < simd_alignment || (header.alignment & (header.alignment - 1)) != 0 ||
+            header.data_offset % header.alignment != 0 || header.data_offset < sizeof(Header))
+        {
+            error = "array file is corrupted";
+        }
+        else if(header.data_offset > image_size || header.data_size > image_size - header.data_offset)
+        {
+            error = "array file is truncated";
+        }
+        // divided instead of multiplied, so huge counts can not wrap around
+        else if(header.stride < header.count ||
+            (header.layout == 1 ? header.stride : header.count) > header.data_size / (components * header.scalar_size))
+        {
+            error = "array file is corrupted";
+        }
+        if(error)
+        {
+            Unmap();
+            header = {};
+            throw std::runtime_error(error);
+        }
+    }
+
+    template<typename T>
+    void ArrayFile::Write(const std::string& path, Vector2SoA<const T> data, ArrayLayout layout, std::size_t alignment)
+    {
+        const unsigned char* sources[] = { reinterpret_cast<const unsigned char*>(data.x), reinterpret_cast<const unsigned char*>(data.y) };
+        WriteFile(path, ArrayElement::vector2, ScalarKind<T>(), sizeof(T), 2, sources, sizeof(T), data.size, layout, alignment);
+    }
+
+    template<typename T>
+    void ArrayFile::Write(const std::string& path, ComplexSoA<const T> data, ArrayLayout layout, std::size_t alignment)
+    {
+        const unsigned char* sources[] = { reinterpret_cast<const unsigned char*>(data.re), reinterpret_cast<const unsigned char*>(data.im) };
+        WriteFile(path, ArrayElement::complex, ScalarKind<T>(), sizeof(T), 2, sources, sizeof(T), data.size, layout, alignment);
+    }
+
+    template<typename T>
+    void ArrayFile::Write(const std::string& path, Vector3SoA<const T> data, ArrayLayout layout, std::size_t alignment)
+    {
+        const unsigned char* sources[] =
+        {
+            reinterpret_cast<const unsigned char*>(data.x),
+            reinterpret_cast<const unsigned char*>(data.y),
+            reinterpret_cast<const unsigned char*>(data.z)
+        };
+        WriteFile(path, ArrayElement::vector3, ScalarKind<T>(), sizeof(T), 3, sources, sizeof(T), data.size, layout, alignment);
+    }
+
+    template<typename T>
+    void ArrayFile::Write(const std::string& path, QuaternionSoA<const T> data, ArrayLayout layout, std::size_t alignment)
+    {
+        const unsigned char* sources[] =
+        {
+            reinterpret_cast<const unsigned char*>(data.re),
+            reinterpret_cast<const unsigned char*>(data.x),
+            reinterpret_cast<const unsigned char*>(data.y),
+            reinterpret_cast<const unsigned char*>(data.z)
+        };
+        WriteFile(path, ArrayElement::quaternion, ScalarKind<T>(), sizeof(T), 4, sources, sizeof(T), data.size, layout, alignment);
+    }
+
+    template<typename ElementT>
+    void ArrayFile::Write(const std::string& path, const ElementT* data, std::size_t count, ArrayLayout layout, std::size_t alignment)
+    {
+        using T = typename Traits<ElementT>::Scalar;
+        constexpr std::size_t components = Traits<ElementT>::components;
+        static_assert(sizeof(ElementT) == components * sizeof(T), "element must be packed");
+
+        const unsigned char* sources[components];
+        for(std::size_t i = 0; i < components; ++i)
+        {
+            sources[i] = reinterpret_cast<const unsigned char*>(data) + i * sizeof(T);
+        }
+        WriteFile(path, Traits<ElementT>::element, ScalarKind<T>(), sizeof(T), components, sources, sizeof(ElementT), count, layout, alignment);
+    }
+
+    inline void ArrayFile::WriteFile(const std::string& path, ArrayElement element, std::uint32_t scalar_kind, std::size_t scalar_size,
+        std::size_t components, const unsigned char* const* sources, std::size_t source_stride, std::size_t count,
+        ArrayLayout layout, std::size_t alignment)
+    {
+        alignment = std::max(alignment, simd_alignment);
+        if((alignment & (alignment - 1)) != 0 || alignment > UINT32_MAX)
+        {
+            throw std::runtime_error("array file alignment must be a power of 2");
+        }
+        auto align = [alignment](std::size_t offset)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        };
+
+        Header header = {};
+        std::memcpy(header.magic, "LARR", 4);
+        header.version = version;
+        header.element = static_cast<std::uint32_t>(element);
+        header.layout = static_cast<std::uint32_t>(layout);
+        header.scalar_kind = scalar_kind;
+        header.scalar_size = static_cast<std::uint32_t>(scalar_size);
+        header.components = static_cast<std::uint32_t>(components);
+        header.alignment = static_cast<std::uint32_t>(alignment);
+        header.count = count;
+        header.stride = layout == ArrayLayout::soa ? align(count * scalar_size) / scalar_size : count;
+        header.data_offset = align(sizeof(Header));
+        header.data_size = layout == ArrayLayout::soa ? header.stride * scalar_size * components : align(count * scalar_size * components);
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if(!file)
+        {
+            throw std::runtime_error("can not create array file " + path);
+        }
+
+        // the payload goes through a staging block, so the checksum always gets whole blocks of 32 bytes
+        std::vector<unsigned char> staging(std::size_t{1} << 16);
+        std::size_t used = 0;
+        Checksum checksum;
+        bool failed = false;
+        for(std::size_t offset = 0; offset < header.data_offset; offset += staging.size())
+        {
+            std::size_t step = std::min<std::size_t>(staging.size(), header.data_offset - offset);
+            failed = failed || std::fwrite(staging.data(), 1, step, file) != step;
+        }
+        auto flush = [&]()
+        {
+            checksum.Add(staging.data(), used);
+            failed = failed || std::fwrite(staging.data(), 1, used, file) != used;
+            used = 0;
+        };
+        auto emit = [&](const unsigned char* bytes, std::size_t size)
+        {
+            while(size)
+            {
+                std::size_t step = std::min(size, staging.size() - used);
+                if(bytes)
+                {
+                    std::memcpy(staging.data() + used, bytes, step);
+                    bytes += step;
+                }
+                else
+                {
+                    std::memset(staging.data() + used, 0, step);
+                }
+                used += step;
+                size -= step;
+                if(used == staging.size())
+                {
+                    flush();
+                }
+            }
+        };
+
+        std::size_t written = 0;
+        if(layout == ArrayLayout::soa)
+        {
+            for(std::size_t c = 0; c < components; ++c)
+            {
+                if(source_stride == scalar_size)
+                {
+                    emit(sources[c], count * scalar_size);
+                }
+                else
+                {
+                    for(std::size_t i = 0; i < count; ++i)
+                    {
+                        emit(sources[c] + i * source_stride, scalar_size);
+                    }
+                }
+                emit(nullptr, header.stride * scalar_size - count * scalar_size);
+            }
+            written = header.data_size;
+        }
+        else
+        {
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                for(std::size_t c = 0; c < components; ++c)
+                {
+                    emit(sources[c] + i * source_stride, scalar_size);
+                }
+            }
+            written = count * scalar_size * components;
+        }
+        emit(nullptr, header.data_size - written);
+        flush();
+
+        header.checksum = checksum.Value();
+        failed = failed || std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(Header), 1, file) != 1;
+        failed = std::fclose(file) != 0 || failed;
+        if(failed)
+        {
+            std::remove(path.c_str());
+            throw std::runtime_error("can not write array file " + path);
+        }
+    }
+
+    inline ArrayElement ArrayFile::Element() const noexcept
+    {
+        return static_cast<ArrayElement>(header.element);
+    }
+
+    inline ArrayLayout ArrayFile::Layout() const noexcept
+    {
+        return static_cast<ArrayLayout>(header.layout);
+    }
+
+    inline std::size_t ArrayFile::Size() const noexcept
+    {
+        return header.count;
+    }
+
+    inline std::size_t ArrayFile::ScalarSize() const noexcept
+    {
+        return header.scalar_size;
+    }
+
+    template<typename T>
+    Vector2SoA<const T> ArrayFile::AsVector2() const
+    {
+        Check<T>(ArrayElement::vector2, ArrayLayout::soa);
+        return { Component<T>(0), Component<T>(1), header.count };
+    }
+
+    template<typename T>
+    ComplexSoA<const T> ArrayFile::AsComplex() const
+    {
+        Check<T>(ArrayElement::complex, ArrayLayout::soa);
+        return { Component<T>(0), Component<T>(1), header.count };
+    }
+
+    template<typename T>
+    Vector3SoA<const T> ArrayFile::AsVector3() const
+    {
+        Check<T>(ArrayElement::vector3, ArrayLayout::soa);
+        return { Component<T>(0), Component<T>(1), Component<T>(2), header.count };
+    }
+
+    template<typename T>
+    QuaternionSoA<const T> ArrayFile::AsQuaternion() const
+    {
+        Check<T>(ArrayElement::quaternion, ArrayLayout::soa);
+        return { Component<T>(0), Component<T>(1), Component<T>(2), Component<T>(3), header.count };
+    }
+
+    template<typename ElementT>
+    const ElementT* ArrayFile::AsArray() const
+    {
+        using T = typename Traits<ElementT>::Scalar;
+        static_assert(sizeof(ElementT) == Traits<ElementT>::components * sizeof(T), "element must be packed");
+        Check<T>(Traits<ElementT>::element, ArrayLayout::aos);
+        return reinterpret_cast<const ElementT*>(image + header.data_offset);
+    }
+
+    inline bool ArrayFile::Verify() const noexcept
+    {
+        if(!image)
+        {
+            return false;
+        }
+        Checksum checksum;
+        checksum.Add(image + header.data_offset, header.data_size);
+        return checksum.Value() == header.checksum;
+    }
+
+    inline void ArrayFile::Prefetch() const noexcept
+    {
+#if !defined(_WIN32)
+        if(image && !storage.Size())
+        {
+            madvise(const_cast<unsigned char*>(image), image_size, MADV_WILLNEED);
+        }
+#endif
+    }
+
+    template<typename T>
+    constexpr std::uint32_t ArrayFile::ScalarKind() noexcept
+    {
+        static_assert(std::is_arithmetic_v<T>, "array files hold arithmetic scalars only");
+        return std::is_floating_point_v<T> ? 0 : std::is_signed_v<T> ? 1 : 2;
+    }
+
+    template<typename T>
+    void ArrayFile::Check(ArrayElement element, ArrayLayout layout) const
+    {
+        if(!image)
+        {
+            throw std::runtime_error("array file is not open");
+        }
+        if(Element() != element || Layout() != layout)
+        {
+            throw std::runtime_error("array file has another element or layout");
+        }
+        if(header.scalar_kind != ScalarKind<T>() || header.scalar_size != sizeof(T))
+        {
+            throw std::runtime_error("array file has another scalar type");
+        }
+    }
+
+    template<typename T>
+    const T* ArrayFile::Component(std::size_t component) const noexcept
+    {
+        return reinterpret_cast<const T*>(image + header.data_offset) + component * header.stride;
+    }
+
+    inline void ArrayFile::Unmap() noexcept
+    {
+#if !defined(_WIN32)
+        if(image && !storage.Size())
+        {
+            munmap(const_cast<unsigned char*>(image), image_size);
+        }
+#endif
+        storage.Resize(0);
+        image = nullptr;
+        image_size = 0;
+    }
+
+    inline void ArrayFile::Checksum::Add(const unsigned char* data, std::size_t data_size) noexcept
+    {
+        constexpr std::uint64_t prime1 = 0x9e3779b185ebca87ull;
+        constexpr std::uint64_t prime2 = 0xc2b2ae3d27d4eb4full;
+        for(std::size_t offset = 0; offset + 32 <= data_size; offset += 32)
+        {
+            for(std::size_t lane = 0; lane < 4; ++lane)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data + offset + lane * 8, 8);
+                std::uint64_t value = lanes[lane] + word * prime2;
+                lanes[lane] = ((value << 31) | (value >> 33)) * prime1;
+            }
+        }
+        size += data_size;
+    }
+
+    inline std::uint64_t ArrayFile::Checksum::Value() const noexcept
+    {
+        std::uint64_t value = size;
+        for(std::size_t lane = 0; lane < 4; ++lane)
+        {
+            value ^= lanes[lane];
+            value = ((value << 27) | (value >> 37)) * 0x9e3779b185ebca87ull + 0x85ebca77c2b2ae63ull;
+        }
+        value ^= value >> 33;
+        value *= 0xc2b2ae3d27d4eb4full;
+        value ^= value >> 29;
+        return value;
+    }
+} // namespace linal
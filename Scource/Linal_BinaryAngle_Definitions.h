@@ -0,0 +1,197 @@
+#pragma once
+#include "Linal.h"
+#include <cmath>
+
+namespace linal
+{
+    template<typename T, unsigned table_bits>
+    constexpr long double BinaryAngleTable<T, table_bits>::Cos(long double x) noexcept
+    {
+        long double term = 1;
+        long double sum = 1;
+        for(int n = 1; n < 16; ++n)
+        {
+            term *= -x * x / ((2 * n - 1) * (2 * n));
+            sum += term;
+        }
+        return sum;
+    }
+
+    template<typename T, unsigned table_bits>
+    constexpr long double BinaryAngleTable<T, table_bits>::Sin(long double x) noexcept
+    {
+        long double term = x;
+        long double sum = x;
+        for(int n = 1; n < 16; ++n)
+        {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    template<typename T, unsigned table_bits>
+    constexpr std::array<T, BinaryAngleTable<T, table_bits>::size + 1> BinaryAngleTable<T, table_bits>::Make(bool cosine) noexcept
+    {
+        static_assert(table_bits >= 2, "the table should have at least 4 entries");
+        constexpr std::size_t quarter = size / 4;
+
+        std::array<T, size + 1> table = {};
+        for(std::size_t i = 0; i <= size; ++i)
+        {
+            // the series is evaluated in the first quadrant only, so the cardinal directions are exact
+            std::size_t quadrant = (i / quarter) % 4;
+            long double x = static_cast<long double>(tau) / 4 * static_cast<long double>(i % quarter) / quarter;
+            long double c = Cos(x);
+            long double s = Sin(x);
+            long double re = quadrant == 0 ? c : (quadrant == 1 ? -s : (quadrant == 2 ? -c : s));
+            long double im = quadrant == 0 ? s : (quadrant == 1 ? c : (quadrant == 2 ? -s : -c));
+            table[i] = static_cast<T>(cosine ? re : im);
+        }
+        return table;
+    }
+
+    template<typename UIntT>
+    constexpr BinaryAngle<UIntT>& BinaryAngle<UIntT>::operator+=(const BinaryAngle<UIntT>& other) noexcept
+    {
+        value = static_cast<UIntT>(value + other.value);
+        return *this;
+    }
+
+    template<typename UIntT>
+    constexpr BinaryAngle<UIntT>& BinaryAngle<UIntT>::operator-=(const BinaryAngle<UIntT>& other) noexcept
+    {
+        value = static_cast<UIntT>(value - other.value);
+        return *this;
+    }
+
+    template<typename UIntT>
+    constexpr BinaryAngle<UIntT> BinaryAngle<UIntT>::operator+(const BinaryAngle<UIntT>& other) const noexcept
+    {
+        return BinaryAngle<UIntT>(*this) += other;
+    }
+
+    template<typename UIntT>
+    constexpr BinaryAngle<UIntT> BinaryAngle<UIntT>::operator-(const BinaryAngle<UIntT>& other) const noexcept
+    {
+        return BinaryAngle<UIntT>(*this) -= other;
+    }
+
+    template<typename UIntT>
+    constexpr BinaryAngle<UIntT> BinaryAngle<UIntT>::operator-() const noexcept
+    {
+        return { static_cast<UIntT>(0u - value) };
+    }
+
+    template<typename UIntT>
+    constexpr bool BinaryAngle<UIntT>::operator==(const BinaryAngle<UIntT>& other) const noexcept
+    {
+        return value == other.value;
+    }
+
+    template<typename UIntT>
+    constexpr bool BinaryAngle<UIntT>::operator!=(const BinaryAngle<UIntT>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    template<typename UIntT>
+    template<typename T>
+    BinaryAngle<UIntT> BinaryAngle<UIntT>::FromRadians(const T& angle) noexcept
+    {
+        constexpr long double steps = static_cast<long double>(std::uint64_t{1} << bits);
+        long double turns = static_cast<long double>(angle) / tau;
+        turns -= std::floor(turns);
+        // a full turn after rounding wraps to zero in the cast
+        return { static_cast<UIntT>(static_cast<std::uint64_t>(turns * steps + 0.5L)) };
+    }
+
+    template<typename UIntT>
+    template<typename T>
+    T BinaryAngle<UIntT>::ToRadians() const noexcept
+    {
+        constexpr long double step = static_cast<long double>(tau) / static_cast<long double>(std::uint64_t{1} << bits);
+        return static_cast<T>(value * step);
+    }
+
+    template<typename UIntT>
+    template<typename T, unsigned table_bits>
+    Rotator2<T> BinaryAngle<UIntT>::ToRotator() const noexcept
+    {
+        static_assert(table_bits <= bits, "table is more precise than the angle");
+        using Table = BinaryAngleTable<T, table_bits>;
+        constexpr unsigned shift = bits - table_bits;
+        // rounding up to the last entry is fine, it repeats the first one
+        std::size_t index = static_cast<std::size_t>((std::uint64_t{value} + ((std::uint64_t{1} << shift) >> 1)) >> shift);
+        return Rotator2<T>(Complex<T>{ Table::re[index], Table::im[index] });
+    }
+
+    template<typename UIntT>
+    template<typename T, unsigned table_bits>
+    Rotator2<T> BinaryAngle<UIntT>::ToRotatorLerp() const noexcept
+    {
+        static_assert(table_bits <= bits, "table is more precise than the angle");
+        using Table = BinaryAngleTable<T, table_bits>;
+        constexpr unsigned shift = bits - table_bits;
+        constexpr T step = T(1) / static_cast<T>(std::uint64_t{1} << shift);
+        std::size_t index = value >> shift;
+        T fraction = static_cast<T>(value & ((std::uint64_t{1} << shift) - 1)) * step;
+        return Rotator2<T>(Complex<T>
+        {
+            Table::re[index] + (Table::re[index + 1] - Table::re[index]) * fraction,
+            Table::im[index] + (Table::im[index + 1] - Table::im[index]) * fraction
+        });
+    }
+
+    template<typename UIntT>
+    template<typename T, unsigned table_bits>
+    void BinaryAngle<UIntT>::ToRotators(const BinaryAngle<UIntT>* angles, ComplexSoA<T> rotators, bool interpolate) noexcept
+    {
+        static_assert(table_bits <= bits, "table is more precise than the angle");
+        using Table = BinaryAngleTable<T, table_bits>;
+        constexpr unsigned shift = bits - table_bits;
+        constexpr std::uint64_t mask = (std::uint64_t{1} << shift) - 1;
+        constexpr T step = T(1) / static_cast<T>(std::uint64_t{1} << shift);
+        const T* re = Table::re.data();
+        const T* im = Table::im.data();
+
+        if(interpolate)
+        {
+            for(std::size_t i = 0; i < rotators.size; ++i)
+            {
+                std::uint32_t index = static_cast<std::uint32_t>(angles[i].value >> shift);
+                T fraction = static_cast<T>(static_cast<std::uint32_t>(angles[i].value & mask)) * step;
+                rotators.re[i] = re[index] + (re[index + 1] - re[index]) * fraction;
+                rotators.im[i] = im[index] + (im[index + 1] - im[index]) * fraction;
+            }
+        }
+        else
+        {
+            for(std::size_t i = 0; i < rotators.size; ++i)
+            {
+                std::uint32_t index = static_cast<std::uint32_t>((std::uint64_t{angles[i].value} + ((mask + 1) >> 1)) >> shift);
+                rotators.re[i] = re[index];
+                rotators.im[i] = im[index];
+            }
+        }
+    }
+
+    template<typename UIntT>
+    template<typename T, unsigned table_bits>
+    void BinaryAngle<UIntT>::ToRotators(const Execution& execution, const BinaryAngle<UIntT>* angles, ComplexSoA<T> rotators, bool interpolate)
+    {
+        Parallel::For(rotators.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            ToRotators<T, table_bits>(angles + begin, rotators.Slice(begin, end - begin), interpolate);
+        }, execution);
+    }
+
+    template<typename UIntT>
+    const BinaryAngle<UIntT> BinaryAngle<UIntT>::zero = { 0 };
+
+    template<typename UIntT>
+    const BinaryAngle<UIntT> BinaryAngle<UIntT>::quarter = { static_cast<UIntT>(std::uint64_t{1} << (bits - 2)) };
+
+    template<typename UIntT>
+    const BinaryAngle<UIntT> BinaryAngle<UIntT>::half = { static_cast<UIntT>(std::uint64_t{1} << (bits - 1)) };
+} // namespace linal
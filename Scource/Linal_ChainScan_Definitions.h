@@ -0,0 +1,195 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+
+namespace linal
+{
+
+    template<typename T>
+    inline std::array<T, 4> ChainScan<T>::ComposeLane(const std::array<T, 4>& a, const std::array<T, 4>& b) noexcept
+    {
+        // the offset of b is rotated by the complex product
+        return
+        {
+            a[0] * b[0] - a[1] * b[1],
+            a[0] * b[1] + a[1] * b[0],
+            a[2] + b[2] * a[0] - b[3] * a[1],
+            a[3] + b[2] * a[1] + b[3] * a[0]
+        };
+    }
+
+    template<typename T>
+    inline std::array<T, 7> ChainScan<T>::ComposeLane(const std::array<T, 7>& a, const std::array<T, 7>& b) noexcept
+    {
+        // a.q * v * conjugate(a.q) == v + re * t + im x t with t = 2 * im x v
+        const T tx = T(2) * (a[2] * b[6] - a[3] * b[5]);
+        const T ty = T(2) * (a[3] * b[4] - a[1] * b[6]);
+        const T tz = T(2) * (a[1] * b[5] - a[2] * b[4]);
+        return
+        {
+            a[0] * b[0] - (a[1] * b[1] + a[2] * b[2] + a[3] * b[3]),
+            a[0] * b[1] + b[0] * a[1] + (a[2] * b[3] - a[3] * b[2]),
+            a[0] * b[2] + b[0] * a[2] + (a[3] * b[1] - a[1] * b[3]),
+            a[0] * b[3] + b[0] * a[3] + (a[1] * b[2] - a[2] * b[1]),
+            a[4] + b[4] + a[0] * tx + (a[2] * tz - a[3] * ty),
+            a[5] + b[5] + a[0] * ty + (a[3] * tx - a[1] * tz),
+            a[6] + b[6] + a[0] * tz + (a[1] * ty - a[2] * tx)
+        };
+    }
+
+    template<typename T>
+    template<typename PointerT, std::size_t components>
+    std::array<T, components> ChainScan<T>::Load(const std::array<PointerT, components>& data, std::size_t index) noexcept
+    {
+        std::array<T, components> link;
+        for(std::size_t c = 0; c < components; ++c)
+        {
+            link[c] = data[c][index];
+        }
+        return link;
+    }
+
+    template<typename T>
+    template<std::size_t components>
+    void ChainScan<T>::Store(const std::array<T*, components>& data, std::size_t index, const std::array<T, components>& link) noexcept
+    {
+        for(std::size_t c = 0; c < components; ++c)
+        {
+            data[c][index] = link[c];
+        }
+    }
+
+    template<typename T>
+    template<std::size_t components>
+    void ChainScan<T>::Scan(const std::array<const T*, components>& input, const std::array<T*, components>& output,
+        std::size_t begin, std::size_t count) noexcept
+    {
+        if(count == 0)
+        {
+            return;
+        }
+        std::array<T, components> carry = Load(input, begin);
+        Store(output, begin, carry);
+        for(std::size_t index = begin + 1; index < begin + count; ++index)
+        {
+            carry = ComposeLane(carry, Load(input, index));
+            Store(output, index, carry);
+        }
+    }
+
+    template<typename T>
+    template<std::size_t components>
+    void ChainScan<T>::Apply(const std::array<T, components>& carry, const std::array<T*, components>& output,
+        std::size_t begin, std::size_t count) noexcept
+    {
+        // the links are independent here. they go through a local tile, so the compiler sees that the components
+        // do not alias and runs the products in simd lanes
+        T links[components][tile];
+        for(std::size_t tile_begin = begin; tile_begin < begin + count; tile_begin += tile)
+        {
+            const std::size_t size = std::min(tile, begin + count - tile_begin);
+            for(std::size_t c = 0; c < components; ++c)
+            {
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    links[c][i] = output[c][tile_begin + i];
+                }
+            }
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                std::array<T, components> link;
+                for(std::size_t c = 0; c < components; ++c)
+                {
+                    link[c] = links[c][i];
+                }
+                link = ComposeLane(carry, link);
+                for(std::size_t c = 0; c < components; ++c)
+                {
+                    links[c][i] = link[c];
+                }
+            }
+            for(std::size_t c = 0; c < components; ++c)
+            {
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    output[c][tile_begin + i] = links[c][i];
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    template<std::size_t components>
+    void ChainScan<T>::Scan(const Execution& execution, const std::array<const T*, components>& input, const std::array<T*, components>& output,
+        std::size_t count)
+    {
+        const std::size_t grain = Parallel::batch_grain;
+        const std::size_t blocks = (count + grain - 1) / grain;
+        // the blocks do not depend on the thread count, so every policy reassociates the same way.
+        // one block is the plain scan
+        if(blocks < 2)
+        {
+            Scan(input, output, 0, count);
+            return;
+        }
+        // blocks are scanned on their own
+        Parallel::For(count, grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t block_begin = begin; block_begin < end; block_begin += grain)
+            {
+                Scan(input, output, block_begin, std::min(grain, end - block_begin));
+            }
+        }, execution);
+
+        // carry of a block is the product of the blocks before it, its last link is the product of the block
+        std::vector<std::array<T, components>> carries(blocks);
+        carries[1] = Load(output, grain - 1);
+        for(std::size_t block = 2; block < blocks; ++block)
+        {
+            carries[block] = ComposeLane(carries[block - 1], Load(output, block * grain - 1));
+        }
+
+        Parallel::For(count - grain, grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t block_begin = grain + begin; block_begin < grain + end; block_begin += grain)
+            {
+                Apply(carries[block_begin / grain], output, block_begin, std::min(grain, grain + end - block_begin));
+            }
+        }, execution);
+    }
+
+    template<typename T>
+    void ChainScan<T>::Compose(ComplexSoA<const T> rotations, Vector2SoA<const T> offsets,
+        ComplexSoA<T> world_rotations, Vector2SoA<T> world_offsets) noexcept
+    {
+        Scan<4>({rotations.re, rotations.im, offsets.x, offsets.y},
+            {world_rotations.re, world_rotations.im, world_offsets.x, world_offsets.y}, 0, rotations.size);
+    }
+
+    template<typename T>
+    void ChainScan<T>::Compose(QuaternionSoA<const T> rotations, Vector3SoA<const T> offsets,
+        QuaternionSoA<T> world_rotations, Vector3SoA<T> world_offsets) noexcept
+    {
+        Scan<7>({rotations.re, rotations.x, rotations.y, rotations.z, offsets.x, offsets.y, offsets.z},
+            {world_rotations.re, world_rotations.x, world_rotations.y, world_rotations.z, world_offsets.x, world_offsets.y, world_offsets.z},
+            0, rotations.size);
+    }
+
+    template<typename T>
+    void ChainScan<T>::Compose(const Execution& execution, ComplexSoA<const T> rotations, Vector2SoA<const T> offsets,
+        ComplexSoA<T> world_rotations, Vector2SoA<T> world_offsets)
+    {
+        Scan<4>(execution, {rotations.re, rotations.im, offsets.x, offsets.y},
+            {world_rotations.re, world_rotations.im, world_offsets.x, world_offsets.y}, rotations.size);
+    }
+
+    template<typename T>
+    void ChainScan<T>::Compose(const Execution& execution, QuaternionSoA<const T> rotations, Vector3SoA<const T> offsets,
+        QuaternionSoA<T> world_rotations, Vector3SoA<T> world_offsets)
+    {
+        Scan<7>(execution, {rotations.re, rotations.x, rotations.y, rotations.z, offsets.x, offsets.y, offsets.z},
+            {world_rotations.re, world_rotations.x, world_rotations.y, world_rotations.z, world_offsets.x, world_offsets.y, world_offsets.z},
+            rotations.size);
+    }
+
+} // namespace linal
@@ -1,5 +1,6 @@
 #pragma once
 #include "Linal.h"
+#include <cmath>
 
 namespace linal
 {
@@ -157,6 +158,331 @@ namespace linal
         return Complex<T>(*this).Normalize(std::forward(sqrt_calculator));
     }
 
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::ExpLane(const T& re, const T& im, T& result_re, T& result_im, MathT&& math_calculator) noexcept
+    {
+        const T length = math_calculator.Exp(re);
+        const T cos = math_calculator.Cos(im);
+        const T sin = math_calculator.Sin(im);
+        result_re = length * cos;
+        result_im = length * sin;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::LogLane(const T& re, const T& im, T& result_re, T& result_im, MathT&& math_calculator) noexcept
+    {
+        // log|z| = log(|z|^2) / 2 saves the sqrt
+        const T angle = math_calculator.Atan2(im, re);
+        result_re = T(0.5) * math_calculator.Log(re * re + im * im);
+        result_im = angle;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::SqrtLane(const T& re, const T& im, T& result_re, T& result_im, MathT&& math_calculator) noexcept
+    {
+        // t = sqrt((|re| + |z|) / 2) never cancels, the other part is |im| / 2t
+        const T abs_re = re < 0 ? -re : re;
+        const T abs_im = im < 0 ? -im : im;
+        const T t = math_calculator.Sqrt((abs_re + math_calculator.Sqrt(re * re + im * im)) * T(0.5));
+        const T other = abs_im / (t > 0 ? t + t : T(1));
+        // the sign of im, including the one of -0, picks the side of the branch cut like std::sqrt
+        const T signed_t = std::copysign(t, im);
+        const T other_im = std::copysign(other, im);
+        result_re = re < 0 ? other : t;
+        result_im = re < 0 ? signed_t : other_im;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::PowLane(const T& re, const T& im, const T& exponent_re, const T& exponent_im, T& result_re, T& result_im,
+        MathT&& math_calculator) noexcept
+    {
+        // zero is replaced by one so that the log stays finite, then the result is selected
+        const bool zero = re == 0 && im == 0;
+        const bool zero_exponent = exponent_re == 0 && exponent_im == 0;
+        T log_re, log_im;
+        LogLane(zero ? T(1) : re, im, log_re, log_im, math_calculator);
+        T power_re, power_im;
+        ExpLane(exponent_re * log_re - exponent_im * log_im, exponent_re * log_im + exponent_im * log_re, power_re, power_im,
+            math_calculator);
+        // zero to a power like std::pow
+        const T infinity = std::numeric_limits<T>::infinity();
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        const T zero_re = exponent_re > 0 ? T(0) : (zero_exponent ? T(1) : (exponent_re < 0 ? infinity : nan));
+        const T zero_im = exponent_re > 0 || zero_exponent || exponent_re < 0 ? T(0) : nan;
+        result_re = zero ? zero_re : power_re;
+        result_im = zero ? zero_im : power_im;
+    }
+
+    template<typename T>
+    Complex<T> Complex<T>::Exp() const noexcept
+    {
+        return Exp(StdMath<T>());
+    }
+
+    template<typename T>
+    Complex<T> Complex<T>::Log() const noexcept
+    {
+        return Log(StdMath<T>());
+    }
+
+    template<typename T>
+    Complex<T> Complex<T>::Sqrt() const noexcept
+    {
+        return Sqrt(StdMath<T>());
+    }
+
+    template<typename T>
+    Complex<T> Complex<T>::Pow(const Complex<T>& exponent) const noexcept
+    {
+        return Pow(exponent, StdMath<T>());
+    }
+
+    template<typename T>
+    Complex<T> Complex<T>::Pow(const T& exponent) const noexcept
+    {
+        return Pow(exponent, StdMath<T>());
+    }
+
+    template<typename T>
+    T Complex<T>::Arg() const noexcept
+    {
+        return Arg(StdMath<T>());
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Complex<T> Complex<T>::Exp(MathT&& math_calculator) const noexcept
+    {
+        Complex<T> result;
+        ExpLane(re, im, result.re, result.im, math_calculator);
+        return result;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Complex<T> Complex<T>::Log(MathT&& math_calculator) const noexcept
+    {
+        Complex<T> result;
+        LogLane(re, im, result.re, result.im, math_calculator);
+        return result;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Complex<T> Complex<T>::Sqrt(MathT&& math_calculator) const noexcept
+    {
+        Complex<T> result;
+        SqrtLane(re, im, result.re, result.im, math_calculator);
+        return result;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Complex<T> Complex<T>::Pow(const Complex<T>& exponent, MathT&& math_calculator) const noexcept
+    {
+        Complex<T> result;
+        PowLane(re, im, exponent.re, exponent.im, result.re, result.im, math_calculator);
+        return result;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Complex<T> Complex<T>::Pow(const T& exponent, MathT&& math_calculator) const noexcept
+    {
+        Complex<T> result;
+        PowLane(re, im, exponent, T(0), result.re, result.im, math_calculator);
+        return result;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    T Complex<T>::Arg(MathT&& math_calculator) const noexcept
+    {
+        return math_calculator.Atan2(im, re);
+    }
+
+    template<typename T>
+    Complex<T> Complex<T>::FromPolar(const T& radius, const T& angle) noexcept
+    {
+        return FromPolar(radius, angle, StdMath<T>());
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Complex<T> Complex<T>::FromPolar(const T& radius, const T& angle, MathT&& math_calculator) noexcept
+    {
+        return Complex<T>{radius * math_calculator.Cos(angle), radius * math_calculator.Sin(angle)};
+    }
+
+    template<typename T>
+    void Complex<T>::Exp(ComplexSoA<const T> z, ComplexSoA<T> result) noexcept
+    {
+        Exp(z, result, StdMath<T>());
+    }
+
+    template<typename T>
+    void Complex<T>::Log(ComplexSoA<const T> z, ComplexSoA<T> result) noexcept
+    {
+        Log(z, result, StdMath<T>());
+    }
+
+    template<typename T>
+    void Complex<T>::Sqrt(ComplexSoA<const T> z, ComplexSoA<T> result) noexcept
+    {
+        Sqrt(z, result, StdMath<T>());
+    }
+
+    template<typename T>
+    void Complex<T>::Pow(ComplexSoA<const T> z, const Complex<T>& exponent, ComplexSoA<T> result) noexcept
+    {
+        Pow(z, exponent, result, StdMath<T>());
+    }
+
+    template<typename T>
+    void Complex<T>::ToPolar(ComplexSoA<const T> z, T* radius, T* angle) noexcept
+    {
+        ToPolar(z, radius, angle, StdMath<T>());
+    }
+
+    template<typename T>
+    void Complex<T>::FromPolar(const T* radius, const T* angle, ComplexSoA<T> result) noexcept
+    {
+        FromPolar(radius, angle, result, StdMath<T>());
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Exp(ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator) noexcept
+    {
+        for(std::size_t i = 0; i < z.size; ++i)
+        {
+            ExpLane(z.re[i], z.im[i], result.re[i], result.im[i], math_calculator);
+        }
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Log(ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator) noexcept
+    {
+        for(std::size_t i = 0; i < z.size; ++i)
+        {
+            LogLane(z.re[i], z.im[i], result.re[i], result.im[i], math_calculator);
+        }
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Sqrt(ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator) noexcept
+    {
+        for(std::size_t i = 0; i < z.size; ++i)
+        {
+            SqrtLane(z.re[i], z.im[i], result.re[i], result.im[i], math_calculator);
+        }
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Pow(ComplexSoA<const T> z, const Complex<T>& exponent, ComplexSoA<T> result, MathT&& math_calculator) noexcept
+    {
+        const T exponent_re = exponent.re;
+        const T exponent_im = exponent.im;
+        for(std::size_t i = 0; i < z.size; ++i)
+        {
+            PowLane(z.re[i], z.im[i], exponent_re, exponent_im, result.re[i], result.im[i], math_calculator);
+        }
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::ToPolar(ComplexSoA<const T> z, T* radius, T* angle, MathT&& math_calculator) noexcept
+    {
+        for(std::size_t i = 0; i < z.size; ++i)
+        {
+            const T re = z.re[i];
+            const T im = z.im[i];
+            radius[i] = math_calculator.Sqrt(re * re + im * im);
+            angle[i] = math_calculator.Atan2(im, re);
+        }
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::FromPolar(const T* radius, const T* angle, ComplexSoA<T> result, MathT&& math_calculator) noexcept
+    {
+        for(std::size_t i = 0; i < result.size; ++i)
+        {
+            const T r = radius[i];
+            const T a = angle[i];
+            result.re[i] = r * math_calculator.Cos(a);
+            result.im[i] = r * math_calculator.Sin(a);
+        }
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Exp(const Execution& execution, ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator)
+    {
+        Parallel::For(z.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Exp(z.Slice(begin, end - begin), result.Slice(begin, end - begin), math_calculator);
+        }, execution);
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Log(const Execution& execution, ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator)
+    {
+        Parallel::For(z.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Log(z.Slice(begin, end - begin), result.Slice(begin, end - begin), math_calculator);
+        }, execution);
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Sqrt(const Execution& execution, ComplexSoA<const T> z, ComplexSoA<T> result, MathT&& math_calculator)
+    {
+        Parallel::For(z.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Sqrt(z.Slice(begin, end - begin), result.Slice(begin, end - begin), math_calculator);
+        }, execution);
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::Pow(const Execution& execution, ComplexSoA<const T> z, const Complex<T>& exponent, ComplexSoA<T> result,
+        MathT&& math_calculator)
+    {
+        Parallel::For(z.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Pow(z.Slice(begin, end - begin), exponent, result.Slice(begin, end - begin), math_calculator);
+        }, execution);
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::ToPolar(const Execution& execution, ComplexSoA<const T> z, T* radius, T* angle, MathT&& math_calculator)
+    {
+        Parallel::For(z.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            ToPolar(z.Slice(begin, end - begin), radius + begin, angle + begin, math_calculator);
+        }, execution);
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Complex<T>::FromPolar(const Execution& execution, const T* radius, const T* angle, ComplexSoA<T> result, MathT&& math_calculator)
+    {
+        Parallel::For(result.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            FromPolar(radius + begin, angle + begin, result.Slice(begin, end - begin), math_calculator);
+        }, execution);
+    }
+
     template<typename T>
     bool Complex<T>::operator == (const Complex<T>& other) const noexcept 
     {
@@ -0,0 +1,356 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cmath>
+
+namespace linal
+{
+    template<typename T, std::size_t dimensions>
+    CubicCurve<T, dimensions> CubicCurve<T, dimensions>::Bezier(const VectorT& p0, const VectorT& p1, const VectorT& p2, const VectorT& p3) noexcept
+    {
+        static constexpr T basis[4][4] =
+        {
+            { -1,  3, -3, 1 },
+            {  3, -6,  3, 0 },
+            { -3,  3,  0, 0 },
+            {  1,  0,  0, 0 }
+        };
+        return FromBasis(p0, p1, p2, p3, basis);
+    }
+
+    template<typename T, std::size_t dimensions>
+    CubicCurve<T, dimensions> CubicCurve<T, dimensions>::Hermite(const VectorT& p0, const VectorT& m0, const VectorT& p1, const VectorT& m1) noexcept
+    {
+        static constexpr T basis[4][4] =
+        {
+            {  2,  1, -2,  1 },
+            { -3, -2,  3, -1 },
+            {  0,  1,  0,  0 },
+            {  1,  0,  0,  0 }
+        };
+        return FromBasis(p0, m0, p1, m1, basis);
+    }
+
+    template<typename T, std::size_t dimensions>
+    CubicCurve<T, dimensions> CubicCurve<T, dimensions>::CatmullRom(const VectorT& p0, const VectorT& p1, const VectorT& p2, const VectorT& p3) noexcept
+    {
+        static constexpr T basis[4][4] =
+        {
+            { T(-0.5), T( 1.5), T(-1.5), T( 0.5) },
+            { T( 1.0), T(-2.5), T( 2.0), T(-0.5) },
+            { T(-0.5), T( 0.0), T( 0.5), T( 0.0) },
+            { T( 0.0), T( 1.0), T( 0.0), T( 0.0) }
+        };
+        return FromBasis(p0, p1, p2, p3, basis);
+    }
+
+    template<typename T, std::size_t dimensions>
+    typename CubicCurve<T, dimensions>::VectorT CubicCurve<T, dimensions>::Evaluate(const T& t) const noexcept
+    {
+        T result[dimensions];
+        for(std::size_t c = 0; c < dimensions; ++c)
+        {
+            result[c] = ((coefficients[0][c] * t + coefficients[1][c]) * t + coefficients[2][c]) * t + coefficients[3][c];
+        }
+        return Compose(result);
+    }
+
+    template<typename T, std::size_t dimensions>
+    typename CubicCurve<T, dimensions>::VectorT CubicCurve<T, dimensions>::Derivative(const T& t) const noexcept
+    {
+        T result[dimensions];
+        for(std::size_t c = 0; c < dimensions; ++c)
+        {
+            result[c] = (T(3) * coefficients[0][c] * t + T(2) * coefficients[1][c]) * t + coefficients[2][c];
+        }
+        return Compose(result);
+    }
+
+    template<typename T, std::size_t dimensions>
+    std::array<typename CubicCurve<T, dimensions>::VectorT, 4> CubicCurve<T, dimensions>::ControlPoints() const noexcept
+    {
+        T points[4][dimensions];
+        for(std::size_t c = 0; c < dimensions; ++c)
+        {
+            const T a = coefficients[0][c];
+            const T b = coefficients[1][c];
+            const T d1 = coefficients[2][c];
+            const T d0 = coefficients[3][c];
+            points[0][c] = d0;
+            points[1][c] = d0 + d1 / T(3);
+            points[2][c] = d0 + (T(2) * d1 + b) / T(3);
+            points[3][c] = a + b + d1 + d0;
+        }
+        return { Compose(points[0]), Compose(points[1]), Compose(points[2]), Compose(points[3]) };
+    }
+
+    template<typename T, std::size_t dimensions>
+    void CubicCurve<T, dimensions>::Evaluate(const T* parameters, SoAT points) const noexcept
+    {
+        T* out[3] = { points.x, points.y, nullptr };
+        if constexpr(dimensions == 3)
+        {
+            out[2] = points.z;
+        }
+        for(std::size_t c = 0; c < dimensions; ++c)
+        {
+            const T a = coefficients[0][c];
+            const T b = coefficients[1][c];
+            const T d1 = coefficients[2][c];
+            const T d0 = coefficients[3][c];
+            T* result = out[c];
+            for(std::size_t i = 0; i < points.size; ++i)
+            {
+                const T t = parameters[i];
+                result[i] = ((a * t + b) * t + d1) * t + d0;
+            }
+        }
+    }
+
+    template<typename T, std::size_t dimensions>
+    void CubicCurve<T, dimensions>::EvaluateUniform(const T& t0, const T& t1, SoAT points) const noexcept
+    {
+        if(points.size == 0)
+        {
+            return;
+        }
+        T* out[3] = { points.x, points.y, nullptr };
+        if constexpr(dimensions == 3)
+        {
+            out[2] = points.z;
+        }
+        const T step = points.size > 1 ? (t1 - t0) / T(points.size - 1) : T(0);
+        for(std::size_t c = 0; c < dimensions; ++c)
+        {
+            auto value = [&](const T& t)
+            {
+                return ((coefficients[0][c] * t + coefficients[1][c]) * t + coefficients[2][c]) * t + coefficients[3][c];
+            };
+            // third differences of a cubic are constant
+            const T f0 = value(t0);
+            const T f1 = value(t0 + step);
+            const T f2 = value(t0 + T(2) * step);
+            const T f3 = value(t0 + T(3) * step);
+            T f = f0;
+            T delta1 = f1 - f0;
+            T delta2 = f2 - T(2) * f1 + f0;
+            const T delta3 = f3 - T(3) * f2 + T(3) * f1 - f0;
+            T* result = out[c];
+            for(std::size_t i = 0; i < points.size; ++i)
+            {
+                result[i] = f;
+                f += delta1;
+                delta1 += delta2;
+                delta2 += delta3;
+            }
+        }
+    }
+
+    template<typename T, std::size_t dimensions>
+    void CubicCurve<T, dimensions>::EvaluateUniform(const CubicCurve<T, dimensions>* curves, std::size_t count, std::size_t samples, SoAT points, const Execution& execution)
+    {
+        Parallel::For(count, curve_grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                curves[i].EvaluateUniform(T(0), T(1), points.Slice(i * samples, samples));
+            }
+        }, execution);
+    }
+
+    template<typename T, std::size_t dimensions>
+    void CubicCurve<T, dimensions>::Flatten(const T& tolerance, std::vector<VectorT>& polyline) const
+    {
+        // subdivides Bezier control polygons depth first, so pieces come out in order
+        constexpr std::size_t max_depth = 16;
+        using Polygon = std::array<std::array<T, dimensions>, 4>;
+        Polygon stack[max_depth + 1];
+        std::size_t depths[max_depth + 1];
+
+        const std::array<VectorT, 4> control = ControlPoints();
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            stack[0][i] = Components(control[i]);
+        }
+        depths[0] = 0;
+        std::size_t top = 1;
+        polyline.push_back(control[0]);
+
+        // the curve is within tolerance of the chord if this bound holds (Willcocks)
+        const T limit = T(16) * tolerance * tolerance;
+        while(top)
+        {
+            --top;
+            const Polygon p = stack[top];
+            const std::size_t depth = depths[top];
+
+            T flatness = 0;
+            for(std::size_t c = 0; c < dimensions; ++c)
+            {
+                const T u = T(3) * p[1][c] - T(2) * p[0][c] - p[3][c];
+                const T v = T(3) * p[2][c] - p[0][c] - T(2) * p[3][c];
+                flatness += std::max(u * u, v * v);
+            }
+            if(flatness <= limit || depth == max_depth)
+            {
+                polyline.push_back(Compose(p[3].data()));
+                continue;
+            }
+
+            Polygon left;
+            Polygon right;
+            for(std::size_t c = 0; c < dimensions; ++c)
+            {
+                const T p01 = (p[0][c] + p[1][c]) * T(0.5);
+                const T p12 = (p[1][c] + p[2][c]) * T(0.5);
+                const T p23 = (p[2][c] + p[3][c]) * T(0.5);
+                const T p012 = (p01 + p12) * T(0.5);
+                const T p123 = (p12 + p23) * T(0.5);
+                const T middle = (p012 + p123) * T(0.5);
+                left[0][c] = p[0][c];
+                left[1][c] = p01;
+                left[2][c] = p012;
+                left[3][c] = middle;
+                right[0][c] = middle;
+                right[1][c] = p123;
+                right[2][c] = p23;
+                right[3][c] = p[3][c];
+            }
+            stack[top] = right;
+            depths[top] = depth + 1;
+            stack[top + 1] = left;
+            depths[top + 1] = depth + 1;
+            top += 2;
+        }
+    }
+
+    template<typename T, std::size_t dimensions>
+    void CubicCurve<T, dimensions>::Flatten(const CubicCurve<T, dimensions>* curves, std::size_t count, const T& tolerance,
+        std::vector<std::size_t>& offsets, std::vector<VectorT>& points, const Execution& execution)
+    {
+        // every chunk collects its own points in one buffer, chunk bounds are multiples of the grain so begin / curve_grain numbers them.
+        // chunks are concatenated in order
+        std::vector<std::vector<VectorT>> chunk_points((count + curve_grain - 1) / curve_grain);
+        offsets.assign(count + 1, 0);
+        Parallel::For(count, curve_grain, [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<VectorT>& found = chunk_points[begin / curve_grain];
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t before = found.size();
+                curves[i].Flatten(tolerance, found);
+                offsets[i + 1] = found.size() - before;
+            }
+        }, execution);
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            offsets[i + 1] += offsets[i];
+        }
+        points.clear();
+        points.reserve(offsets[count]);
+        for(const std::vector<VectorT>& found : chunk_points)
+        {
+            points.insert(points.end(), found.begin(), found.end());
+        }
+    }
+
+    template<typename T, std::size_t dimensions>
+    std::vector<T> CubicCurve<T, dimensions>::ArcLengthTable(std::size_t segments) const
+    {
+        // 5 point Gauss-Legendre nodes and weights on [-1, 1]
+        static constexpr T nodes[5] = { T(-0.906179845938664), T(-0.538469310105683), T(0), T(0.538469310105683), T(0.906179845938664) };
+        static constexpr T weights[5] = { T(0.236926885056189), T(0.478628670499366), T(0.568888888888889), T(0.478628670499366), T(0.236926885056189) };
+
+        segments = std::max<std::size_t>(segments, 1);
+        std::vector<T> table(segments + 1, T(0));
+        const T half = T(0.5) / T(segments);
+        for(std::size_t i = 0; i < segments; ++i)
+        {
+            const T middle = (T(i) + T(0.5)) / T(segments);
+            T length = 0;
+            for(std::size_t k = 0; k < 5; ++k)
+            {
+                const T t = middle + half * nodes[k];
+                T speed2 = 0;
+                for(std::size_t c = 0; c < dimensions; ++c)
+                {
+                    const T derivative = (T(3) * coefficients[0][c] * t + T(2) * coefficients[1][c]) * t + coefficients[2][c];
+                    speed2 += derivative * derivative;
+                }
+                length += weights[k] * std::sqrt(speed2);
+            }
+            table[i + 1] = table[i] + length * half;
+        }
+        return table;
+    }
+
+    template<typename T, std::size_t dimensions>
+    T CubicCurve<T, dimensions>::ParameterAt(const std::vector<T>& table, const T& length) noexcept
+    {
+        if(table.size() < 2 || !(length > table.front()))
+        {
+            return T(0);
+        }
+        if(!(length < table.back()))
+        {
+            return T(1);
+        }
+        const std::size_t segments = table.size() - 1;
+        const std::size_t i = static_cast<std::size_t>(std::upper_bound(table.begin(), table.end(), length) - table.begin()) - 1;
+        const T span = table[i + 1] - table[i];
+        const T fraction = span > 0 ? (length - table[i]) / span : T(0);
+        return (T(i) + fraction) / T(segments);
+    }
+
+    template<typename T, std::size_t dimensions>
+    void CubicCurve<T, dimensions>::ParametersAt(const std::vector<T>& table, const T* lengths, T* parameters, std::size_t count) noexcept
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            parameters[i] = ParameterAt(table, lengths[i]);
+        }
+    }
+
+    template<typename T, std::size_t dimensions>
+    std::array<T, dimensions> CubicCurve<T, dimensions>::Components(const VectorT& vector) noexcept
+    {
+        if constexpr(dimensions == 2)
+        {
+            return { vector.x, vector.y };
+        }
+        else
+        {
+            return { vector.x, vector.y, vector.z };
+        }
+    }
+
+    template<typename T, std::size_t dimensions>
+    typename CubicCurve<T, dimensions>::VectorT CubicCurve<T, dimensions>::Compose(const T* components) noexcept
+    {
+        if constexpr(dimensions == 2)
+        {
+            return { components[0], components[1] };
+        }
+        else
+        {
+            return { components[0], components[1], components[2] };
+        }
+    }
+
+    template<typename T, std::size_t dimensions>
+    CubicCurve<T, dimensions> CubicCurve<T, dimensions>::FromBasis(const VectorT& p0, const VectorT& p1, const VectorT& p2, const VectorT& p3, const T (&basis)[4][4]) noexcept
+    {
+        const std::array<T, dimensions> points[4] = { Components(p0), Components(p1), Components(p2), Components(p3) };
+        CubicCurve<T, dimensions> curve;
+        for(std::size_t row = 0; row < 4; ++row)
+        {
+            for(std::size_t c = 0; c < dimensions; ++c)
+            {
+                curve.coefficients[row][c] = basis[row][0] * points[0][c] + basis[row][1] * points[1][c] +
+                    basis[row][2] * points[2][c] + basis[row][3] * points[3][c];
+            }
+        }
+        return curve;
+    }
+} // namespace linal
@@ -0,0 +1,592 @@
+#pragma once
+#include "Linal.h"
+#include <cstring>
+
+namespace linal
+{
+    template<typename T>
+    Fft<T>::Fft(std::size_t size)
+        : size(size)
+    {
+        if(size == 0)
+        {
+            throw std::runtime_error("fft size must be positive");
+        }
+
+        std::vector<std::size_t> radices;
+        std::size_t rest = size;
+        while(rest % 4 == 0)
+        {
+            radices.push_back(4);
+            rest /= 4;
+        }
+        while(rest % 2 == 0)
+        {
+            radices.push_back(2);
+            rest /= 2;
+        }
+        for(std::size_t p = 3; p * p <= rest; p += 2)
+        {
+            while(rest % p == 0)
+            {
+                radices.push_back(p);
+                rest /= p;
+            }
+        }
+        if(rest > 1)
+        {
+            radices.push_back(rest);
+        }
+
+        // twiddles are computed in long double, so float plans get correctly rounded values
+        auto root = [](std::size_t k, std::size_t n)
+        {
+            return Rotator2<long double>::RadianRot(-static_cast<long double>(tau) * static_cast<long double>(k) / static_cast<long double>(n));
+        };
+
+        std::size_t length = size;
+        std::size_t stride = 1;
+        for(std::size_t radix : radices)
+        {
+            Pass pass = { radix, length / radix, stride, twiddle_re.size(), 0 };
+            for(std::size_t j = 1; j < radix; ++j)
+            {
+                for(std::size_t q = 0; q < pass.length; ++q)
+                {
+                    Rotator2<long double> w = root(q * j % length, length);
+                    twiddle_re.push_back(static_cast<T>(w.GetRe()));
+                    twiddle_im.push_back(static_cast<T>(w.GetIm()));
+                }
+            }
+            if(radix != 2 && radix != 4)
+            {
+                pass.roots = twiddle_re.size();
+                for(std::size_t r = 0; r < radix; ++r)
+                {
+                    Rotator2<long double> w = root(r, radix);
+                    twiddle_re.push_back(static_cast<T>(w.GetRe()));
+                    twiddle_im.push_back(static_cast<T>(w.GetIm()));
+                }
+            }
+            passes.push_back(pass);
+            length = pass.length;
+            stride *= radix;
+        }
+    }
+
+    template<typename T>
+    std::size_t Fft<T>::Size() const noexcept
+    {
+        return size;
+    }
+
+    template<typename T>
+    std::vector<std::size_t> Fft<T>::Radices() const
+    {
+        std::vector<std::size_t> radices;
+        for(const Pass& pass : passes)
+        {
+            radices.push_back(pass.radix);
+        }
+        return radices;
+    }
+
+    template<typename T>
+    void Fft<T>::Forward(ComplexSoA<const T> input, ComplexSoA<T> output) const
+    {
+        Run<false>(input.re, input.im, output.re, output.im);
+    }
+
+    template<typename T>
+    void Fft<T>::Inverse(ComplexSoA<const T> input, ComplexSoA<T> output) const
+    {
+        Run<true>(input.re, input.im, output.re, output.im);
+    }
+
+    template<typename T>
+    void Fft<T>::Forward(const Complex<T>* input, Complex<T>* output) const
+    {
+        RunInterleaved<false>(input, output);
+    }
+
+    template<typename T>
+    void Fft<T>::Inverse(const Complex<T>* input, Complex<T>* output) const
+    {
+        RunInterleaved<true>(input, output);
+    }
+
+    template<typename T>
+    template<bool inverse>
+    void Fft<T>::Run(const T* input_re, const T* input_im, T* output_re, T* output_im) const
+    {
+        if(size == 0)
+        {
+            return;
+        }
+        FrameScope scope;
+        ComplexBuffer<T> scratch(size, &scope.GetArena());
+        Run<inverse>(input_re, input_im, output_re, output_im, scratch.Component(0), scratch.Component(1));
+    }
+
+    template<typename T>
+    template<bool inverse>
+    void Fft<T>::Run(const T* input_re, const T* input_im, T* output_re, T* output_im, T* scratch_re, T* scratch_im) const noexcept
+    {
+        // the passes ping pong between the buffers, the start is chosen so the last pass writes the output
+        T* x_re = output_re;
+        T* x_im = output_im;
+        T* y_re = scratch_re;
+        T* y_im = scratch_im;
+        if(passes.size() % 2 == 1)
+        {
+            std::swap(x_re, y_re);
+            std::swap(x_im, y_im);
+        }
+        if(x_re != input_re)
+        {
+            std::memcpy(x_re, input_re, size * sizeof(T));
+            std::memcpy(x_im, input_im, size * sizeof(T));
+        }
+
+        for(const Pass& pass : passes)
+        {
+            RunPass<inverse>(pass, x_re, x_im, y_re, y_im);
+            std::swap(x_re, y_re);
+            std::swap(x_im, y_im);
+        }
+
+        if(inverse)
+        {
+            const T scale = T(1) / T(size);
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                output_re[i] *= scale;
+                output_im[i] *= scale;
+            }
+        }
+    }
+
+    template<typename T>
+    template<bool inverse>
+    void Fft<T>::RunPass(const Pass& pass, const T* x_re, const T* x_im, T* y_re, T* y_im) const noexcept
+    {
+        // y[k + s * (p * q + j)] = w^(q * j) * sum_r x[k + s * (q + m * r)] * exp(-i * tau * r * j / p), k < s is the inner loop
+        const std::size_t p = pass.radix;
+        const std::size_t m = pass.length;
+        const std::size_t s = pass.stride;
+        const T* w_re = twiddle_re.data() + pass.twiddles;
+        const T* w_im = twiddle_im.data() + pass.twiddles;
+        const T sign = inverse ? T(-1) : T(1);
+
+        if(p == 2)
+        {
+            for(std::size_t q = 0; q < m; ++q)
+            {
+                const T wr = w_re[q];
+                const T wi = sign * w_im[q];
+                const T* x0r = x_re + s * q;
+                const T* x0i = x_im + s * q;
+                const T* x1r = x_re + s * (q + m);
+                const T* x1i = x_im + s * (q + m);
+                T* y0r = y_re + s * (2 * q);
+                T* y0i = y_im + s * (2 * q);
+                T* y1r = y_re + s * (2 * q + 1);
+                T* y1i = y_im + s * (2 * q + 1);
+                for(std::size_t k = 0; k < s; ++k)
+                {
+                    const T dr = x0r[k] - x1r[k];
+                    const T di = x0i[k] - x1i[k];
+                    y0r[k] = x0r[k] + x1r[k];
+                    y0i[k] = x0i[k] + x1i[k];
+                    y1r[k] = dr * wr - di * wi;
+                    y1i[k] = dr * wi + di * wr;
+                }
+            }
+        }
+        else if(p == 4)
+        {
+            for(std::size_t q = 0; q < m; ++q)
+            {
+                const T w1r = w_re[q];
+                const T w1i = sign * w_im[q];
+                const T w2r = w_re[m + q];
+                const T w2i = sign * w_im[m + q];
+                const T w3r = w_re[2 * m + q];
+                const T w3i = sign * w_im[2 * m + q];
+                const T* x0r = x_re + s * q;
+                const T* x0i = x_im + s * q;
+                const T* x1r = x_re + s * (q + m);
+                const T* x1i = x_im + s * (q + m);
+                const T* x2r = x_re + s * (q + 2 * m);
+                const T* x2i = x_im + s * (q + 2 * m);
+                const T* x3r = x_re + s * (q + 3 * m);
+                const T* x3i = x_im + s * (q + 3 * m);
+                T* y0r = y_re + s * (4 * q);
+                T* y0i = y_im + s * (4 * q);
+                T* y1r = y_re + s * (4 * q + 1);
+                T* y1i = y_im + s * (4 * q + 1);
+                T* y2r = y_re + s * (4 * q + 2);
+                T* y2i = y_im + s * (4 * q + 2);
+                T* y3r = y_re + s * (4 * q + 3);
+                T* y3i = y_im + s * (4 * q + 3);
+                for(std::size_t k = 0; k < s; ++k)
+                {
+                    const T t0r = x0r[k] + x2r[k];
+                    const T t0i = x0i[k] + x2i[k];
+                    const T t1r = x0r[k] - x2r[k];
+                    const T t1i = x0i[k] - x2i[k];
+                    const T t2r = x1r[k] + x3r[k];
+                    const T t2i = x1i[k] + x3i[k];
+                    // (x1 - x3) * -i, or * i for the inverse
+                    const T t3r = sign * (x1i[k] - x3i[k]);
+                    const T t3i = sign * (x3r[k] - x1r[k]);
+
+                    y0r[k] = t0r + t2r;
+                    y0i[k] = t0i + t2i;
+                    const T a1r = t1r + t3r;
+                    const T a1i = t1i + t3i;
+                    const T a2r = t0r - t2r;
+                    const T a2i = t0i - t2i;
+                    const T a3r = t1r - t3r;
+                    const T a3i = t1i - t3i;
+                    y1r[k] = a1r * w1r - a1i * w1i;
+                    y1i[k] = a1r * w1i + a1i * w1r;
+                    y2r[k] = a2r * w2r - a2i * w2i;
+                    y2i[k] = a2r * w2i + a2i * w2r;
+                    y3r[k] = a3r * w3r - a3i * w3i;
+                    y3i[k] = a3r * w3i + a3i * w3r;
+                }
+            }
+        }
+        else
+        {
+            const T* root_re = twiddle_re.data() + pass.roots;
+            const T* root_im = twiddle_im.data() + pass.roots;
+            for(std::size_t q = 0; q < m; ++q)
+            {
+                for(std::size_t j = 0; j < p; ++j)
+                {
+                    T* yr = y_re + s * (p * q + j);
+                    T* yi = y_im + s * (p * q + j);
+                    for(std::size_t k = 0; k < s; ++k)
+                    {
+                        yr[k] = 0;
+                        yi[k] = 0;
+                    }
+                    for(std::size_t r = 0; r < p; ++r)
+                    {
+                        const T cr = root_re[r * j % p];
+                        const T ci = sign * root_im[r * j % p];
+                        const T* xr = x_re + s * (q + m * r);
+                        const T* xi = x_im + s * (q + m * r);
+                        for(std::size_t k = 0; k < s; ++k)
+                        {
+                            yr[k] += xr[k] * cr - xi[k] * ci;
+                            yi[k] += xr[k] * ci + xi[k] * cr;
+                        }
+                    }
+                    if(j > 0)
+                    {
+                        const T wr = w_re[(j - 1) * m + q];
+                        const T wi = sign * w_im[(j - 1) * m + q];
+                        for(std::size_t k = 0; k < s; ++k)
+                        {
+                            const T ar = yr[k];
+                            const T ai = yi[k];
+                            yr[k] = ar * wr - ai * wi;
+                            yi[k] = ar * wi + ai * wr;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    template<bool inverse>
+    void Fft<T>::RunInterleaved(const Complex<T>* input, Complex<T>* output) const
+    {
+        FrameScope scope;
+        ComplexBuffer<T> split(size, &scope.GetArena());
+        T* re = split.Component(0);
+        T* im = split.Component(1);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            re[i] = input[i].re;
+            im[i] = input[i].im;
+        }
+        Run<inverse>(re, im, re, im);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            output[i].re = re[i];
+            output[i].im = im[i];
+        }
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    RealFft<T>::RealFft(std::size_t size)
+        : size(size), half(size / 2)
+    {
+        if(size == 0 || size % 2 != 0)
+        {
+            throw std::runtime_error("real fft size must be even");
+        }
+        for(std::size_t k = 0; k <= size / 2; ++k)
+        {
+            Rotator2<long double> w = Rotator2<long double>::RadianRot(-static_cast<long double>(tau) * static_cast<long double>(k) / static_cast<long double>(size));
+            twiddle_re.push_back(static_cast<T>(w.GetRe()));
+            twiddle_im.push_back(static_cast<T>(w.GetIm()));
+        }
+    }
+
+    template<typename T>
+    std::size_t RealFft<T>::Size() const noexcept
+    {
+        return size;
+    }
+
+    template<typename T>
+    void RealFft<T>::Forward(const T* input, ComplexSoA<T> spectrum) const
+    {
+        // even samples are the real part, odd samples the imaginary part of a half size transform
+        const std::size_t h = size / 2;
+        T* re = spectrum.re;
+        T* im = spectrum.im;
+        for(std::size_t j = 0; j < h; ++j)
+        {
+            re[j] = input[2 * j];
+            im[j] = input[2 * j + 1];
+        }
+        half.Forward(ComplexSoA<const T>{ re, im, h }, ComplexSoA<T>{ re, im, h });
+
+        // X[k] = E[k] + w^k * O[k], E = (Z[k] + conj(Z[h - k])) / 2, O = -i * (Z[k] - conj(Z[h - k])) / 2
+        // X[h - k] uses conj(E) and conj(O), so k and h - k are computed together in place
+        const T z0r = re[0];
+        const T z0i = im[0];
+        re[0] = z0r + z0i;
+        im[0] = 0;
+        re[h] = z0r - z0i;
+        im[h] = 0;
+        for(std::size_t k = 1; k <= h / 2; ++k)
+        {
+            const std::size_t l = h - k;
+            const T even_re = (re[k] + re[l]) * T(0.5);
+            const T even_im = (im[k] - im[l]) * T(0.5);
+            const T odd_re = (im[k] + im[l]) * T(0.5);
+            const T odd_im = (re[l] - re[k]) * T(0.5);
+            const T wkr = twiddle_re[k];
+            const T wki = twiddle_im[k];
+            const T wlr = twiddle_re[l];
+            const T wli = twiddle_im[l];
+            re[k] = even_re + odd_re * wkr - odd_im * wki;
+            im[k] = even_im + odd_re * wki + odd_im * wkr;
+            re[l] = even_re + odd_re * wlr + odd_im * wli;
+            im[l] = -even_im + odd_re * wli - odd_im * wlr;
+        }
+    }
+
+    template<typename T>
+    void RealFft<T>::Forward(const T* input, Complex<T>* spectrum) const
+    {
+        FrameScope scope;
+        ComplexBuffer<T> split(size / 2 + 1, &scope.GetArena());
+        Forward(input, split.AsComplex());
+        for(std::size_t k = 0; k <= size / 2; ++k)
+        {
+            spectrum[k].re = split.Component(0)[k];
+            spectrum[k].im = split.Component(1)[k];
+        }
+    }
+
+    template<typename T>
+    void RealFft<T>::Inverse(ComplexSoA<const T> spectrum, T* output) const
+    {
+        // Z[k] = E[k] + i * O[k], E = (X[k] + conj(X[h - k])) / 2, O = (X[k] - conj(X[h - k])) * conj(w^k) / 2
+        const std::size_t h = size / 2;
+        FrameScope scope;
+        ComplexBuffer<T> z(h, &scope.GetArena());
+        T* re = z.Component(0);
+        T* im = z.Component(1);
+        for(std::size_t k = 0; k < h; ++k)
+        {
+            const std::size_t l = h - k;
+            const T even_re = (spectrum.re[k] + spectrum.re[l]) * T(0.5);
+            const T even_im = (spectrum.im[k] - spectrum.im[l]) * T(0.5);
+            const T dr = (spectrum.re[k] - spectrum.re[l]) * T(0.5);
+            const T di = (spectrum.im[k] + spectrum.im[l]) * T(0.5);
+            const T wr = twiddle_re[k];
+            const T wi = -twiddle_im[k];
+            const T odd_re = dr * wr - di * wi;
+            const T odd_im = dr * wi + di * wr;
+            re[k] = even_re - odd_im;
+            im[k] = even_im + odd_re;
+        }
+        half.Inverse(ComplexSoA<const T>{ re, im, h }, ComplexSoA<T>{ re, im, h });
+        for(std::size_t j = 0; j < h; ++j)
+        {
+            output[2 * j] = re[j];
+            output[2 * j + 1] = im[j];
+        }
+    }
+
+    template<typename T>
+    void RealFft<T>::Inverse(const Complex<T>* spectrum, T* output) const
+    {
+        FrameScope scope;
+        ComplexBuffer<T> split(size / 2 + 1, &scope.GetArena());
+        for(std::size_t k = 0; k <= size / 2; ++k)
+        {
+            split.Component(0)[k] = spectrum[k].re;
+            split.Component(1)[k] = spectrum[k].im;
+        }
+        Inverse(ComplexSoA<const T>{ split.Component(0), split.Component(1), size / 2 + 1 }, output);
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    FftConvolver<T>::FftConvolver(ComplexSoA<const T> filter, std::size_t block_size, std::size_t channels, std::pmr::memory_resource* resource)
+        : block_size(block_size), filter_size(filter.size), channels(channels), spectrum(0, resource), windows(0, resource), scratch(0, resource)
+    {
+        if(block_size == 0 || filter.size == 0 || channels == 0)
+        {
+            throw std::runtime_error("convolver needs a filter, a block size and a channel");
+        }
+
+        // every block needs filter_size - 1 samples of history in front of it
+        std::size_t size = 1;
+        while(size < block_size + filter.size - 1)
+        {
+            size *= 2;
+        }
+        fft = Fft<T>(size);
+
+        spectrum.Resize(size);
+        std::memcpy(spectrum.Component(0), filter.re, filter.size * sizeof(T));
+        std::memcpy(spectrum.Component(1), filter.im, filter.size * sizeof(T));
+        std::memset(spectrum.Component(0) + filter.size, 0, (size - filter.size) * sizeof(T));
+        std::memset(spectrum.Component(1) + filter.size, 0, (size - filter.size) * sizeof(T));
+        fft.Forward(spectrum.AsComplex(), spectrum.AsComplex());
+
+        windows.Resize(size * channels);
+        scratch.Resize(ScratchSize() * channels);
+        Reset();
+    }
+
+    template<typename T>
+    std::size_t FftConvolver<T>::BlockSize() const noexcept
+    {
+        return block_size;
+    }
+
+    template<typename T>
+    std::size_t FftConvolver<T>::FilterSize() const noexcept
+    {
+        return filter_size;
+    }
+
+    template<typename T>
+    std::size_t FftConvolver<T>::FftSize() const noexcept
+    {
+        return fft.Size();
+    }
+
+    template<typename T>
+    std::size_t FftConvolver<T>::Channels() const noexcept
+    {
+        return channels;
+    }
+
+    template<typename T>
+    void FftConvolver<T>::Process(ComplexSoA<const T> input, ComplexSoA<T> output, std::size_t channel)
+    {
+        if(channel >= channels)
+        {
+            throw std::runtime_error("no such convolver channel");
+        }
+        const std::size_t size = fft.Size();
+        const std::size_t kept = size - block_size;
+        T* window_re = windows.Component(0) + channel * size;
+        T* window_im = windows.Component(1) + channel * size;
+        std::memmove(window_re, window_re + block_size, kept * sizeof(T));
+        std::memmove(window_im, window_im + block_size, kept * sizeof(T));
+        std::memcpy(window_re + kept, input.re, block_size * sizeof(T));
+        std::memcpy(window_im + kept, input.im, block_size * sizeof(T));
+
+        T* work_re = scratch.Component(0) + channel * ScratchSize();
+        T* work_im = scratch.Component(1) + channel * ScratchSize();
+        fft.template Run<false>(window_re, window_im, work_re, work_im, work_re + size, work_im + size);
+
+        const T* filter_re = spectrum.Component(0);
+        const T* filter_im = spectrum.Component(1);
+        for(std::size_t k = 0; k < size; ++k)
+        {
+            const T re = work_re[k] * filter_re[k] - work_im[k] * filter_im[k];
+            const T im = work_re[k] * filter_im[k] + work_im[k] * filter_re[k];
+            work_re[k] = re;
+            work_im[k] = im;
+        }
+        fft.template Run<true>(work_re, work_im, work_re, work_im, work_re + size, work_im + size);
+
+        // the first kept samples are wrapped around by the circular convolution, the tail is exact
+        std::memcpy(output.re, work_re + kept, block_size * sizeof(T));
+        std::memcpy(output.im, work_im + kept, block_size * sizeof(T));
+    }
+
+    template<typename T>
+    void FftConvolver<T>::Process(const Complex<T>* input, Complex<T>* output, std::size_t channel)
+    {
+        if(channel >= channels)
+        {
+            throw std::runtime_error("no such convolver channel");
+        }
+        // the split lives behind the transform scratch of the channel
+        ComplexSoA<T> split =
+        {
+            scratch.Component(0) + channel * ScratchSize() + 2 * fft.Size(),
+            scratch.Component(1) + channel * ScratchSize() + 2 * fft.Size(),
+            block_size
+        };
+        for(std::size_t i = 0; i < block_size; ++i)
+        {
+            split.re[i] = input[i].re;
+            split.im[i] = input[i].im;
+        }
+        Process(split, split, channel);
+        for(std::size_t i = 0; i < block_size; ++i)
+        {
+            output[i].re = split.re[i];
+            output[i].im = split.im[i];
+        }
+    }
+
+    template<typename T>
+    void FftConvolver<T>::Process(const Execution& execution, ComplexSoA<const T> input, ComplexSoA<T> output)
+    {
+        Parallel::For(channels, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t c = begin; c < end; ++c)
+            {
+                Process(input.Slice(c * block_size, block_size), output.Slice(c * block_size, block_size), c);
+            }
+        }, execution);
+    }
+
+    template<typename T>
+    std::size_t FftConvolver<T>::ScratchSize() const noexcept
+    {
+        return 2 * fft.Size() + block_size;
+    }
+
+    template<typename T>
+    void FftConvolver<T>::Reset() noexcept
+    {
+        if(windows.Size())
+        {
+            std::memset(windows.Component(0), 0, windows.Size() * sizeof(T));
+            std::memset(windows.Component(1), 0, windows.Size() * sizeof(T));
+        }
+    }
+} // namespace linal
@@ -0,0 +1,307 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace linal
+{
+    inline FrameArena::FrameArena(std::size_t chunk_size, std::pmr::memory_resource* upstream)
+        : upstream(upstream), chunk_size(std::max(chunk_size, simd_alignment))
+    {}
+
+    inline FrameArena::~FrameArena()
+    {
+        Release();
+    }
+
+    inline FrameArena::Marker FrameArena::GetMarker() const noexcept
+    {
+        return top;
+    }
+
+    inline void FrameArena::Rewind(const Marker& marker) noexcept
+    {
+        top = marker;
+    }
+
+    inline void FrameArena::Reset() noexcept
+    {
+        top = {};
+    }
+
+    inline void FrameArena::Release() noexcept
+    {
+        for(const Chunk& chunk : chunks)
+        {
+            upstream->deallocate(chunk.data, chunk.size, simd_alignment);
+        }
+        chunks.clear();
+        top = {};
+    }
+
+    inline std::size_t FrameArena::BytesReserved() const noexcept
+    {
+        std::size_t bytes = 0;
+        for(const Chunk& chunk : chunks)
+        {
+            bytes += chunk.size;
+        }
+        return bytes;
+    }
+
+    inline FrameArena& FrameArena::ThreadLocal()
+    {
+        thread_local FrameArena arena;
+        return arena;
+    }
+
+    inline void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        // chunks are only simd aligned, larger alignments are applied to the address and not to the offset
+        alignment = std::max(alignment, simd_alignment);
+        auto fits = [&](std::size_t chunk, std::size_t offset, std::size_t& aligned)
+        {
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunks[chunk].data);
+            aligned = (base + offset + alignment - 1) / alignment * alignment - base;
+            return aligned <= chunks[chunk].size && bytes <= chunks[chunk].size - aligned;
+        };
+
+        std::size_t aligned = 0;
+        if(top.chunk < chunks.size() && fits(top.chunk, top.offset, aligned))
+        {
+            top.offset = aligned + bytes;
+            return chunks[top.chunk].data + aligned;
+        }
+
+        // chunks after the top are free, the first one that is big enough is reused
+        std::size_t next = chunks.empty() ? 0 : top.chunk + 1;
+        while(next < chunks.size() && !fits(next, 0, aligned))
+        {
+            ++next;
+        }
+        if(next == chunks.size())
+        {
+            // a new chunk has room for the worst padding in front of the block
+            std::size_t padded = (bytes + simd_alignment - 1) / simd_alignment * simd_alignment + (alignment - simd_alignment);
+            std::size_t size = std::max(chunk_size, padded);
+            Chunk chunk = { static_cast<unsigned char*>(upstream->allocate(size, simd_alignment)), size };
+            next = chunks.empty() ? 0 : top.chunk + 1;
+            chunks.insert(chunks.begin() + next, chunk);
+            fits(next, 0, aligned);
+        }
+        else if(next != top.chunk + 1)
+        {
+            // keep the chunks in use contiguous
+            std::swap(chunks[next], chunks[top.chunk + 1]);
+            next = top.chunk + 1;
+        }
+
+        top = { next, aligned + bytes };
+        return chunks[next].data + aligned;
+    }
+
+    inline void FrameArena::do_deallocate(void*, std::size_t, std::size_t)
+    {
+    }
+
+    inline bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    inline FrameScope::FrameScope(FrameArena& arena) noexcept
+        : arena(arena), marker(arena.GetMarker())
+    {}
+
+    inline FrameScope::~FrameScope()
+    {
+        arena.Rewind(marker);
+    }
+
+    inline FrameArena& FrameScope::GetArena() const noexcept
+    {
+        return arena;
+    }
+
+    template<typename T, std::size_t components>
+    SoABuffer<T, components>::SoABuffer(std::size_t size, std::pmr::memory_resource* resource)
+        : resource(resource)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SoABuffer holds trivially copyable elements only");
+        static_assert(components > 0, "SoABuffer needs at least one component");
+        Resize(size);
+    }
+
+    template<typename T, std::size_t components>
+    SoABuffer<T, components>::SoABuffer(SoABuffer<T, components>&& other) noexcept
+        : resource(other.resource), data(other.data), size(other.size), stride(other.stride)
+    {
+        other.data = nullptr;
+        other.size = 0;
+        other.stride = 0;
+    }
+
+    template<typename T, std::size_t components>
+    SoABuffer<T, components>& SoABuffer<T, components>::operator=(SoABuffer<T, components>&& other) noexcept
+    {
+        std::swap(resource, other.resource);
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(stride, other.stride);
+        return *this;
+    }
+
+    template<typename T, std::size_t components>
+    SoABuffer<T, components>::~SoABuffer()
+    {
+        if(data)
+        {
+            resource->deallocate(data, stride * components * sizeof(T), simd_alignment);
+        }
+    }
+
+    template<typename T, std::size_t components>
+    void SoABuffer<T, components>::Resize(std::size_t new_size)
+    {
+        std::size_t new_stride = Stride(new_size);
+        if(new_stride == stride)
+        {
+            size = new_size;
+            return;
+        }
+
+        T* new_data = nullptr;
+        if(new_stride)
+        {
+            new_data = static_cast<T*>(resource->allocate(new_stride * components * sizeof(T), simd_alignment));
+            std::size_t kept = std::min(size, new_size);
+            for(std::size_t i = 0; i < components && kept; ++i)
+            {
+                std::memcpy(new_data + i * new_stride, data + i * stride, kept * sizeof(T));
+            }
+        }
+        if(data)
+        {
+            resource->deallocate(data, stride * components * sizeof(T), simd_alignment);
+        }
+        data = new_data;
+        size = new_size;
+        stride = new_stride;
+    }
+
+    template<typename T, std::size_t components>
+    std::size_t SoABuffer<T, components>::Size() const noexcept
+    {
+        return size;
+    }
+
+    template<typename T, std::size_t components>
+    std::pmr::memory_resource* SoABuffer<T, components>::GetResource() const noexcept
+    {
+        return resource;
+    }
+
+    template<typename T, std::size_t components>
+    T* SoABuffer<T, components>::Component(std::size_t component) noexcept
+    {
+        return data + component * stride;
+    }
+
+    template<typename T, std::size_t components>
+    const T* SoABuffer<T, components>::Component(std::size_t component) const noexcept
+    {
+        return data + component * stride;
+    }
+
+    template<typename T, std::size_t components>
+    Vector2SoA<T> SoABuffer<T, components>::AsVector2() noexcept
+    {
+        static_assert(components == 2, "Vector2SoA needs 2 components");
+        return { Component(0), Component(1), size };
+    }
+
+    template<typename T, std::size_t components>
+    Vector2SoA<const T> SoABuffer<T, components>::AsVector2() const noexcept
+    {
+        static_assert(components == 2, "Vector2SoA needs 2 components");
+        return { Component(0), Component(1), size };
+    }
+
+    template<typename T, std::size_t components>
+    ComplexSoA<T> SoABuffer<T, components>::AsComplex() noexcept
+    {
+        static_assert(components == 2, "ComplexSoA needs 2 components");
+        return { Component(0), Component(1), size };
+    }
+
+    template<typename T, std::size_t components>
+    ComplexSoA<const T> SoABuffer<T, components>::AsComplex() const noexcept
+    {
+        static_assert(components == 2, "ComplexSoA needs 2 components");
+        return { Component(0), Component(1), size };
+    }
+
+    template<typename T, std::size_t components>
+    Vector3SoA<T> SoABuffer<T, components>::AsVector3() noexcept
+    {
+        static_assert(components == 3, "Vector3SoA needs 3 components");
+        return { Component(0), Component(1), Component(2), size };
+    }
+
+    template<typename T, std::size_t components>
+    Vector3SoA<const T> SoABuffer<T, components>::AsVector3() const noexcept
+    {
+        static_assert(components == 3, "Vector3SoA needs 3 components");
+        return { Component(0), Component(1), Component(2), size };
+    }
+
+    template<typename T, std::size_t components>
+    QuaternionSoA<T> SoABuffer<T, components>::AsQuaternion() noexcept
+    {
+        static_assert(components == 4, "QuaternionSoA needs 4 components");
+        return { Component(0), Component(1), Component(2), Component(3), size };
+    }
+
+    template<typename T, std::size_t components>
+    QuaternionSoA<const T> SoABuffer<T, components>::AsQuaternion() const noexcept
+    {
+        static_assert(components == 4, "QuaternionSoA needs 4 components");
+        return { Component(0), Component(1), Component(2), Component(3), size };
+    }
+
+    template<typename T, std::size_t components>
+    Matrix2x2SoA<T> SoABuffer<T, components>::AsMatrix2x2() noexcept
+    {
+        static_assert(components == 4, "Matrix2x2SoA needs 4 components");
+        return { Component(0), Component(1), Component(2), Component(3), size };
+    }
+
+    template<typename T, std::size_t components>
+    Matrix2x2SoA<const T> SoABuffer<T, components>::AsMatrix2x2() const noexcept
+    {
+        static_assert(components == 4, "Matrix2x2SoA needs 4 components");
+        return { Component(0), Component(1), Component(2), Component(3), size };
+    }
+
+    template<typename T, std::size_t components>
+    Symmetric3SoA<T> SoABuffer<T, components>::AsSymmetric3() noexcept
+    {
+        static_assert(components == 6, "Symmetric3SoA needs 6 components");
+        return { Component(0), Component(1), Component(2), Component(3), Component(4), Component(5), size };
+    }
+
+    template<typename T, std::size_t components>
+    Symmetric3SoA<const T> SoABuffer<T, components>::AsSymmetric3() const noexcept
+    {
+        static_assert(components == 6, "Symmetric3SoA needs 6 components");
+        return { Component(0), Component(1), Component(2), Component(3), Component(4), Component(5), size };
+    }
+
+    template<typename T, std::size_t components>
+    std::size_t SoABuffer<T, components>::Stride(std::size_t size) noexcept
+    {
+        constexpr std::size_t block = simd_alignment / sizeof(T) ? simd_alignment / sizeof(T) : 1;
+        return (size + block - 1) / block * block;
+    }
+} // namespace linal
@@ -0,0 +1,392 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace linal
+{
+
+    template<typename T>
+    T Plane3<T>::Distance(const Vector3<T>& point) const noexcept
+    {
+        return normal.Dot(point) + distance;
+    }
+
+    template<typename T>
+    Plane3<T> Plane3<T>::Normalized() const noexcept
+    {
+        const T length2 = normal.Abs2();
+        if(!(length2 > 0))
+        {
+            return Plane3<T>{ { 0, 0, 0 }, 1 };
+        }
+        const T inv = T(1) / std::sqrt(length2);
+        return Plane3<T>{ normal * inv, distance * inv };
+    }
+
+    template<typename T>
+    Plane3<T> Plane3<T>::FromPointNormal(const Vector3<T>& point, const Vector3<T>& normal) noexcept
+    {
+        return Plane3<T>{ normal, -normal.Dot(point) };
+    }
+
+    template<typename T>
+    Plane3<T> Plane3<T>::FromPoints(const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& c) noexcept
+    {
+        return FromPointNormal(a, (b - a).Cross(c - a));
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    Frustum<T> Frustum<T>::FromTransform(const Transform3dUniform<T>& view_projection, DepthRange depth) noexcept
+    {
+        // clip coordinate j of a row vector is its product with column j, -w <= x <= w gives (column 3 + column 0) * p >= 0, ...
+        const T* m = view_projection.data();
+        Plane3<T> columns[4];
+        for(std::size_t j = 0; j < 4; ++j)
+        {
+            columns[j] = Plane3<T>{ { m[j], m[4 + j], m[8 + j] }, m[12 + j] };
+        }
+        auto add = [](const Plane3<T>& a, const Plane3<T>& b, const T& sign)
+        {
+            return Plane3<T>{ a.normal + b.normal * sign, a.distance + b.distance * sign }.Normalized();
+        };
+
+        Frustum<T> frustum;
+        frustum.planes[0] = add(columns[3], columns[0], T(1));
+        frustum.planes[1] = add(columns[3], columns[0], T(-1));
+        frustum.planes[2] = add(columns[3], columns[1], T(1));
+        frustum.planes[3] = add(columns[3], columns[1], T(-1));
+        frustum.planes[4] = depth == DepthRange::zero_to_one ? columns[2].Normalized() : add(columns[3], columns[2], T(1));
+        frustum.planes[5] = add(columns[3], columns[2], T(-1));
+        return frustum;
+    }
+
+    template<typename T>
+    bool Frustum<T>::IntersectsSphere(const Vector3<T>& center, const T& radius) const noexcept
+    {
+        bool inside = true;
+        for(const Plane3<T>& plane : planes)
+        {
+            inside &= plane.Distance(center) >= -radius;
+        }
+        return inside;
+    }
+
+    template<typename T>
+    bool Frustum<T>::IntersectsBox(const Vector3<T>& lower, const Vector3<T>& upper) const noexcept
+    {
+        // the corner farthest along the normal is in front, twice its distance is center + extent projected on |normal|
+        const Vector3<T> center = lower + upper;
+        const Vector3<T> extent = upper - lower;
+        bool inside = true;
+        for(const Plane3<T>& plane : planes)
+        {
+            const T reach = extent.x * std::abs(plane.normal.x) + extent.y * std::abs(plane.normal.y) + extent.z * std::abs(plane.normal.z);
+            inside &= plane.normal.Dot(center) + reach + 2 * plane.distance >= 0;
+        }
+        return inside;
+    }
+
+    template<typename T>
+    bool Frustum<T>::SphereOutside(std::size_t p, const T* x, const T* y, const T* z, const T* r, std::size_t l) const noexcept
+    {
+        const Plane3<T>& plane = planes[p];
+        return plane.normal.x * x[l] + plane.normal.y * y[l] + plane.normal.z * z[l] + plane.distance < -r[l];
+    }
+
+    template<typename T>
+    bool Frustum<T>::BoxOutside(std::size_t p, const T* lx, const T* ly, const T* lz, const T* ux, const T* uy, const T* uz,
+        std::size_t l) const noexcept
+    {
+        const Plane3<T>& plane = planes[p];
+        const T center = plane.normal.x * (lx[l] + ux[l]) + plane.normal.y * (ly[l] + uy[l]) + plane.normal.z * (lz[l] + uz[l]);
+        const T reach = std::abs(plane.normal.x) * (ux[l] - lx[l]) + std::abs(plane.normal.y) * (uy[l] - ly[l])
+            + std::abs(plane.normal.z) * (uz[l] - lz[l]);
+        return center + reach + 2 * plane.distance < 0;
+    }
+
+    template<typename T>
+    std::uint64_t Frustum<T>::Pack(const std::uint8_t (&lanes)[word]) noexcept
+    {
+        std::uint64_t mask = 0;
+        for(std::size_t group = 0; group < word / 8; ++group)
+        {
+            // every byte is 0 or 1, the product gathers byte i of a little endian word into bit 56 + i
+            std::uint64_t bytes;
+            std::memcpy(&bytes, lanes + 8 * group, 8);
+            mask |= ((bytes * 0x0102040810204080) >> 56) << (8 * group);
+        }
+        return mask;
+    }
+
+    template<typename T>
+    std::uint64_t Frustum<T>::SphereWord(const T* x, const T* y, const T* z, const T* r, std::size_t count) const noexcept
+    {
+        // planes outside, objects inside, so every plane is one simd loop
+        std::uint8_t inside[word];
+        for(std::size_t l = 0; l < word; ++l)
+        {
+            inside[l] = std::uint8_t(l < count);
+        }
+        for(const Plane3<T>& plane : planes)
+        {
+            for(std::size_t l = 0; l < count; ++l)
+            {
+                inside[l] &= std::uint8_t(plane.normal.x * x[l] + plane.normal.y * y[l] + plane.normal.z * z[l] + plane.distance >= -r[l]);
+            }
+        }
+        return Pack(inside);
+    }
+
+    template<typename T>
+    std::uint64_t Frustum<T>::BoxWord(const T* lx, const T* ly, const T* lz, const T* ux, const T* uy, const T* uz, std::size_t count) const noexcept
+    {
+        std::uint8_t inside[word];
+        for(std::size_t l = 0; l < word; ++l)
+        {
+            inside[l] = std::uint8_t(l < count);
+        }
+        for(const Plane3<T>& plane : planes)
+        {
+            const T ax = std::abs(plane.normal.x);
+            const T ay = std::abs(plane.normal.y);
+            const T az = std::abs(plane.normal.z);
+            for(std::size_t l = 0; l < count; ++l)
+            {
+                // twice the distance of the corner farthest along the normal
+                const T center = plane.normal.x * (lx[l] + ux[l]) + plane.normal.y * (ly[l] + uy[l]) + plane.normal.z * (lz[l] + uz[l]);
+                const T reach = ax * (ux[l] - lx[l]) + ay * (uy[l] - ly[l]) + az * (uz[l] - lz[l]);
+                inside[l] &= std::uint8_t(center + reach + 2 * plane.distance >= 0);
+            }
+        }
+        return Pack(inside);
+    }
+
+    template<typename T>
+    std::uint64_t Frustum<T>::SphereHintWord(const T* x, const T* y, const T* z, const T* r, std::uint8_t* hints, std::size_t count) const noexcept
+    {
+        std::uint64_t mask = 0;
+        for(std::size_t l = 0; l < count; ++l)
+        {
+            hints[l] = hints[l] < 6 ? hints[l] : std::uint8_t(0);
+            mask |= std::uint64_t(SphereOutside(hints[l], x, y, z, r, l)) << l;
+        }
+        return mask;
+    }
+
+    template<typename T>
+    std::uint64_t Frustum<T>::BoxHintWord(const T* lx, const T* ly, const T* lz, const T* ux, const T* uy, const T* uz, std::uint8_t* hints,
+        std::size_t count) const noexcept
+    {
+        std::uint64_t mask = 0;
+        for(std::size_t l = 0; l < count; ++l)
+        {
+            hints[l] = hints[l] < 6 ? hints[l] : std::uint8_t(0);
+            mask |= std::uint64_t(BoxOutside(hints[l], lx, ly, lz, ux, uy, uz, l)) << l;
+        }
+        return mask;
+    }
+
+    template<typename T>
+    template<typename OutsideT>
+    void Frustum<T>::UpdateHints(OutsideT&& outside, std::uint64_t visible, std::uint64_t hint_rejected, std::uint8_t* hints, std::size_t count) noexcept
+    {
+        // only objects that changed planes since the last frame get here
+        const std::uint64_t all = count == word ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+        std::uint64_t stale = ~visible & ~hint_rejected & all;
+        while(stale != 0)
+        {
+            std::size_t l = 0;
+            while(!((stale >> l) & 1))
+            {
+                ++l;
+            }
+            stale &= stale - 1;
+            std::uint8_t p = 0;
+            while(p < 5 && !outside(p, l))
+            {
+                ++p;
+            }
+            hints[l] = p;
+        }
+    }
+
+    template<typename T>
+    void Frustum<T>::CullSpheres(Vector3SoA<const T> centers, const T* radii, std::uint64_t* visible) const noexcept
+    {
+        for(std::size_t begin = 0; begin < centers.size; begin += word)
+        {
+            visible[begin / word] = SphereWord(centers.x + begin, centers.y + begin, centers.z + begin, radii + begin,
+                std::min(word, centers.size - begin));
+        }
+    }
+
+    template<typename T>
+    void Frustum<T>::CullBoxes(Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint64_t* visible) const noexcept
+    {
+        for(std::size_t begin = 0; begin < lower.size; begin += word)
+        {
+            visible[begin / word] = BoxWord(lower.x + begin, lower.y + begin, lower.z + begin, upper.x + begin, upper.y + begin, upper.z + begin,
+                std::min(word, lower.size - begin));
+        }
+    }
+
+    template<typename T>
+    void Frustum<T>::CullSpheres(Vector3SoA<const T> centers, const T* radii, std::uint8_t* hints, std::uint64_t* visible) const noexcept
+    {
+        for(std::size_t begin = 0; begin < centers.size; begin += word)
+        {
+            const std::size_t count = std::min(word, centers.size - begin);
+            const T* x = centers.x + begin;
+            const T* y = centers.y + begin;
+            const T* z = centers.z + begin;
+            const T* r = radii + begin;
+            const std::uint64_t all = count == word ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+            const std::uint64_t hint_rejected = SphereHintWord(x, y, z, r, hints + begin, count);
+            const std::uint64_t mask = hint_rejected == all ? 0 : SphereWord(x, y, z, r, count);
+            UpdateHints([&](std::size_t p, std::size_t l) { return SphereOutside(p, x, y, z, r, l); }, mask, hint_rejected, hints + begin, count);
+            visible[begin / word] = mask;
+        }
+    }
+
+    template<typename T>
+    void Frustum<T>::CullBoxes(Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint8_t* hints, std::uint64_t* visible) const noexcept
+    {
+        for(std::size_t begin = 0; begin < lower.size; begin += word)
+        {
+            const std::size_t count = std::min(word, lower.size - begin);
+            const T* lx = lower.x + begin;
+            const T* ly = lower.y + begin;
+            const T* lz = lower.z + begin;
+            const T* ux = upper.x + begin;
+            const T* uy = upper.y + begin;
+            const T* uz = upper.z + begin;
+            const std::uint64_t all = count == word ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+            const std::uint64_t hint_rejected = BoxHintWord(lx, ly, lz, ux, uy, uz, hints + begin, count);
+            const std::uint64_t mask = hint_rejected == all ? 0 : BoxWord(lx, ly, lz, ux, uy, uz, count);
+            UpdateHints([&](std::size_t p, std::size_t l) { return BoxOutside(p, lx, ly, lz, ux, uy, uz, l); }, mask, hint_rejected, hints + begin, count);
+            visible[begin / word] = mask;
+        }
+    }
+
+    template<typename T>
+    void Frustum<T>::CullSpheres(const Execution& execution, Vector3SoA<const T> centers, const T* radii, std::uint64_t* visible) const
+    {
+        // chunks start at multiples of batch_grain, so every chunk owns whole words
+        Parallel::For(centers.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            CullSpheres(centers.Slice(begin, end - begin), radii + begin, visible + begin / 64);
+        }, execution);
+    }
+
+    template<typename T>
+    void Frustum<T>::CullBoxes(const Execution& execution, Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint64_t* visible) const
+    {
+        Parallel::For(lower.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            CullBoxes(lower.Slice(begin, end - begin), upper.Slice(begin, end - begin), visible + begin / 64);
+        }, execution);
+    }
+
+    template<typename T>
+    void Frustum<T>::CullSpheres(const Execution& execution, Vector3SoA<const T> centers, const T* radii, std::uint8_t* hints,
+        std::uint64_t* visible) const
+    {
+        Parallel::For(centers.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            CullSpheres(centers.Slice(begin, end - begin), radii + begin, hints + begin, visible + begin / 64);
+        }, execution);
+    }
+
+    template<typename T>
+    void Frustum<T>::CullBoxes(const Execution& execution, Vector3SoA<const T> lower, Vector3SoA<const T> upper, std::uint8_t* hints,
+        std::uint64_t* visible) const
+    {
+        Parallel::For(lower.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            CullBoxes(lower.Slice(begin, end - begin), upper.Slice(begin, end - begin), hints + begin, visible + begin / 64);
+        }, execution);
+    }
+
+//==============================================================================================================================================
+
+#if defined(__AVX__)
+
+    template<>
+    inline std::uint64_t Frustum<float>::SphereWord(const float* x, const float* y, const float* z, const float* r, std::size_t count) const noexcept
+    {
+        std::uint64_t mask = 0;
+        std::size_t l = 0;
+        for(; l + 8 <= count; l += 8)
+        {
+            const __m256 vx = _mm256_loadu_ps(x + l);
+            const __m256 vy = _mm256_loadu_ps(y + l);
+            const __m256 vz = _mm256_loadu_ps(z + l);
+            const __m256 negative_r = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(r + l));
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for(const Plane3<float>& plane : planes)
+            {
+                __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.x), vx), _mm256_set1_ps(plane.distance));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), vy));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), vz));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negative_r, _CMP_GE_OQ));
+            }
+            mask |= std::uint64_t(_mm256_movemask_ps(inside)) << l;
+        }
+        for(; l < count; ++l)
+        {
+            mask |= std::uint64_t(IntersectsSphere({ x[l], y[l], z[l] }, r[l])) << l;
+        }
+        return mask;
+    }
+
+    template<>
+    inline std::uint64_t Frustum<float>::BoxWord(const float* lx, const float* ly, const float* lz, const float* ux, const float* uy, const float* uz,
+        std::size_t count) const noexcept
+    {
+        std::uint64_t mask = 0;
+        std::size_t l = 0;
+        for(; l + 8 <= count; l += 8)
+        {
+            const __m256 lower_x = _mm256_loadu_ps(lx + l);
+            const __m256 lower_y = _mm256_loadu_ps(ly + l);
+            const __m256 lower_z = _mm256_loadu_ps(lz + l);
+            const __m256 upper_x = _mm256_loadu_ps(ux + l);
+            const __m256 upper_y = _mm256_loadu_ps(uy + l);
+            const __m256 upper_z = _mm256_loadu_ps(uz + l);
+            // twice the center and the extent
+            const __m256 cx = _mm256_add_ps(lower_x, upper_x);
+            const __m256 cy = _mm256_add_ps(lower_y, upper_y);
+            const __m256 cz = _mm256_add_ps(lower_z, upper_z);
+            const __m256 ex = _mm256_sub_ps(upper_x, lower_x);
+            const __m256 ey = _mm256_sub_ps(upper_y, lower_y);
+            const __m256 ez = _mm256_sub_ps(upper_z, lower_z);
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for(const Plane3<float>& plane : planes)
+            {
+                __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.x), cx), _mm256_set1_ps(2 * plane.distance));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), cy));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), cz));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.normal.x)), ex));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.normal.y)), ey));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.normal.z)), ez));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+            mask |= std::uint64_t(_mm256_movemask_ps(inside)) << l;
+        }
+        for(; l < count; ++l)
+        {
+            mask |= std::uint64_t(IntersectsBox({ lx[l], ly[l], lz[l] }, { ux[l], uy[l], uz[l] })) << l;
+        }
+        return mask;
+    }
+
+#endif
+
+} // namespace linal
@@ -0,0 +1,243 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <limits>
+
+namespace linal
+{
+    template<typename T>
+    std::uint8_t Intersection2<T>::Lane(
+        const T& ax, const T& ay, const T& rx, const T& ry,
+        const T& bx, const T& by, const T& sx, const T& sy,
+        const T& t_max, T& t, T& u) noexcept
+    {
+        // same as r.OrthogonalL().Dot(s), zero for parallel lines
+        T det = rx * sy - ry * sx;
+        T qx = bx - ax;
+        T qy = by - ay;
+
+        // select instead of a branch, the lane is masked out by valid anyway
+        std::uint8_t valid = det != 0;
+        T inv = T(1) / (valid ? det : T(1));
+        t = (qx * sy - qy * sx) * inv;
+        u = (qx * ry - qy * rx) * inv;
+
+        return valid & (t >= 0) & (t <= t_max) & (u >= 0) & (u <= 1);
+    }
+
+    template<typename T>
+    void Intersection2<T>::SegmentSegment(
+        Vector2SoA<const T> a0, Vector2SoA<const T> a1,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t, T* u) noexcept
+    {
+        for(std::size_t i = 0; i < a0.size; ++i)
+        {
+            hit[i] = Lane(
+                a0.x[i], a0.y[i], a1.x[i] - a0.x[i], a1.y[i] - a0.y[i],
+                b0.x[i], b0.y[i], b1.x[i] - b0.x[i], b1.y[i] - b0.y[i],
+                T(1), t[i], u[i]);
+        }
+    }
+
+    template<typename T>
+    void Intersection2<T>::SegmentSegment(
+        const Vector2<T>& a0, const Vector2<T>& a1,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t, T* u) noexcept
+    {
+        Vector2<T> r = a1 - a0;
+        for(std::size_t i = 0; i < b0.size; ++i)
+        {
+            hit[i] = Lane(
+                a0.x, a0.y, r.x, r.y,
+                b0.x[i], b0.y[i], b1.x[i] - b0.x[i], b1.y[i] - b0.y[i],
+                T(1), t[i], u[i]);
+        }
+    }
+
+    template<typename T>
+    void Intersection2<T>::RaySegment(
+        const Vector2<T>& origin, const Vector2<T>& direction,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t) noexcept
+    {
+        constexpr T t_max = std::numeric_limits<T>::max();
+        for(std::size_t i = 0; i < b0.size; ++i)
+        {
+            T u;
+            hit[i] = Lane(
+                origin.x, origin.y, direction.x, direction.y,
+                b0.x[i], b0.y[i], b1.x[i] - b0.x[i], b1.y[i] - b0.y[i],
+                t_max, t[i], u);
+        }
+    }
+
+    template<typename T>
+    void Intersection2<T>::RaySegment(
+        Vector2SoA<const T> origin, Vector2SoA<const T> direction,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t) noexcept
+    {
+        constexpr T t_max = std::numeric_limits<T>::max();
+        for(std::size_t i = 0; i < origin.size; ++i)
+        {
+            T u;
+            hit[i] = Lane(
+                origin.x[i], origin.y[i], direction.x[i], direction.y[i],
+                b0.x[i], b0.y[i], b1.x[i] - b0.x[i], b1.y[i] - b0.y[i],
+                t_max, t[i], u);
+        }
+    }
+
+    template<typename T>
+    std::size_t Intersection2<T>::RayCast(
+        const Vector2<T>& origin, const Vector2<T>& direction,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        T& t) noexcept
+    {
+        constexpr T t_max = std::numeric_limits<T>::max();
+        std::size_t best = b0.size;
+        t = t_max;
+        for(std::size_t i = 0; i < b0.size; ++i)
+        {
+            T lane_t;
+            T lane_u;
+            std::uint8_t hit = Lane(
+                origin.x, origin.y, direction.x, direction.y,
+                b0.x[i], b0.y[i], b1.x[i] - b0.x[i], b1.y[i] - b0.y[i],
+                t_max, lane_t, lane_u);
+            bool closer = hit & (lane_t < t);
+            t = closer ? lane_t : t;
+            best = closer ? i : best;
+        }
+        return best;
+    }
+
+    template<typename T>
+    void Intersection2<T>::PointInPolygon(Vector2SoA<const T> points, Vector2SoA<const T> polygon, std::uint8_t* inside) noexcept
+    {
+        for(std::size_t i = 0; i < points.size; ++i)
+        {
+            inside[i] = 0;
+        }
+        if(polygon.size < 3)
+        {
+            return;
+        }
+
+        // edges are the outer loop so the inner loop over points has no dependencies between lanes
+        for(std::size_t e = 0, prev = polygon.size - 1; e < polygon.size; prev = e++)
+        {
+            const T xi = polygon.x[e];
+            const T yi = polygon.y[e];
+            const T dx = polygon.x[prev] - xi;
+            const T dy = polygon.y[prev] - yi;
+            const bool dy_negative = dy < 0;
+            for(std::size_t i = 0; i < points.size; ++i)
+            {
+                const T px = points.x[i];
+                const T py = points.y[i];
+                std::uint8_t crosses = (yi > py) != (polygon.y[prev] > py);
+                // px < xi + (py - yi) * dx / dy without the division
+                std::uint8_t left = ((px - xi) * dy < (py - yi) * dx) != dy_negative;
+                inside[i] ^= crosses & left;
+            }
+        }
+    }
+
+    template<typename T>
+    void Intersection2<T>::SegmentSegment(const Execution& execution,
+        Vector2SoA<const T> a0, Vector2SoA<const T> a1,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t, T* u)
+    {
+        Parallel::For(a0.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            std::size_t count = end - begin;
+            SegmentSegment(a0.Slice(begin, count), a1.Slice(begin, count), b0.Slice(begin, count), b1.Slice(begin, count),
+                hit + begin, t + begin, u + begin);
+        }, execution);
+    }
+
+    template<typename T>
+    void Intersection2<T>::SegmentSegment(const Execution& execution,
+        const Vector2<T>& a0, const Vector2<T>& a1,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t, T* u)
+    {
+        Parallel::For(b0.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            std::size_t count = end - begin;
+            SegmentSegment(a0, a1, b0.Slice(begin, count), b1.Slice(begin, count), hit + begin, t + begin, u + begin);
+        }, execution);
+    }
+
+    template<typename T>
+    void Intersection2<T>::RaySegment(const Execution& execution,
+        const Vector2<T>& origin, const Vector2<T>& direction,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t)
+    {
+        Parallel::For(b0.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            std::size_t count = end - begin;
+            RaySegment(origin, direction, b0.Slice(begin, count), b1.Slice(begin, count), hit + begin, t + begin);
+        }, execution);
+    }
+
+    template<typename T>
+    void Intersection2<T>::RaySegment(const Execution& execution,
+        Vector2SoA<const T> origin, Vector2SoA<const T> direction,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        std::uint8_t* hit, T* t)
+    {
+        Parallel::For(origin.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            std::size_t count = end - begin;
+            RaySegment(origin.Slice(begin, count), direction.Slice(begin, count), b0.Slice(begin, count), b1.Slice(begin, count),
+                hit + begin, t + begin);
+        }, execution);
+    }
+
+    template<typename T>
+    std::size_t Intersection2<T>::RayCast(const Execution& execution,
+        const Vector2<T>& origin, const Vector2<T>& direction,
+        Vector2SoA<const T> b0, Vector2SoA<const T> b1,
+        T& t)
+    {
+        // one result per block, reduced in order with the same strict comparison as the sequential loop
+        std::size_t blocks = (b0.size + Parallel::batch_grain - 1) / Parallel::batch_grain;
+        std::vector<std::size_t> block_best(blocks, b0.size);
+        std::vector<T> block_t(blocks, std::numeric_limits<T>::max());
+        Parallel::For(b0.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t block_begin = begin; block_begin < end; block_begin += Parallel::batch_grain)
+            {
+                std::size_t count = std::min(Parallel::batch_grain, end - block_begin);
+                std::size_t block = block_begin / Parallel::batch_grain;
+                std::size_t best = RayCast(origin, direction, b0.Slice(block_begin, count), b1.Slice(block_begin, count), block_t[block]);
+                block_best[block] = best < count ? block_begin + best : b0.size;
+            }
+        }, execution);
+
+        std::size_t best = b0.size;
+        t = std::numeric_limits<T>::max();
+        for(std::size_t block = 0; block < blocks; ++block)
+        {
+            bool closer = block_best[block] != b0.size && block_t[block] < t;
+            t = closer ? block_t[block] : t;
+            best = closer ? block_best[block] : best;
+        }
+        return best;
+    }
+
+    template<typename T>
+    void Intersection2<T>::PointInPolygon(const Execution& execution, Vector2SoA<const T> points, Vector2SoA<const T> polygon, std::uint8_t* inside)
+    {
+        Parallel::For(points.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            PointInPolygon(points.Slice(begin, end - begin), polygon, inside + begin);
+        }, execution);
+    }
+} // namespace linal
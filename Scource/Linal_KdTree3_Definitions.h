@@ -0,0 +1,450 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace linal
+{
+    template<typename T>
+    KdTree3<T>::KdTree3(Vector3SoA<const T> source, std::size_t bucket_size, const Execution& execution, std::pmr::memory_resource* resource)
+        : storage(0, resource)
+    {
+        if(source.size >= npos)
+        {
+            throw std::runtime_error("too many points for kd tree");
+        }
+        bucket_size = std::min(std::max<std::size_t>(bucket_size, 1), max_bucket_size);
+
+        depth = 0;
+        while(((source.size + (std::size_t{1} << depth) - 1) >> depth) > bucket_size)
+        {
+            ++depth;
+        }
+
+        std::array<std::size_t, 7> offsets;
+        storage.Resize(ImageLayout(source.size, depth, offsets));
+        unsigned char* data = storage.Component(0);
+
+        Header header = {};
+        std::memcpy(header.magic, "LKD3", 4);
+        header.version = image_version;
+        header.scalar_size = sizeof(T);
+        header.depth = static_cast<std::uint32_t>(depth);
+        header.size = source.size;
+        header.bucket_size = bucket_size;
+        std::memcpy(data, &header, sizeof(Header));
+
+        T* split_out = reinterpret_cast<T*>(data + offsets[0]);
+        std::uint8_t* axis_out = reinterpret_cast<std::uint8_t*>(data + offsets[1]);
+        std::uint32_t* order = reinterpret_cast<std::uint32_t*>(data + offsets[5]);
+        std::iota(order, order + source.size, std::uint32_t{0});
+
+        // the top levels split their nodes in parallel level by level, then every subtree below them is one task
+        std::size_t spawn_levels = 0;
+        while((std::size_t{1} << spawn_levels) < execution.ThreadCount() && spawn_levels < depth)
+        {
+            ++spawn_levels;
+        }
+        std::vector<std::pair<std::size_t, std::size_t>> ranges = { { 0, source.size } };
+        for(std::size_t level = 0; level <= spawn_levels; ++level)
+        {
+            const std::size_t first = (std::size_t{1} << level) - 1;
+            Parallel::For(ranges.size(), 1, [&](std::size_t begin, std::size_t end)
+            {
+                for(std::size_t k = begin; k < end; ++k)
+                {
+                    if(level < spawn_levels)
+                    {
+                        Split(source, order, split_out, axis_out, first + k, ranges[k].first, ranges[k].second);
+                    }
+                    else
+                    {
+                        Build(source, order, split_out, axis_out, first + k, ranges[k].first, ranges[k].second, level);
+                    }
+                }
+            }, execution);
+
+            std::vector<std::pair<std::size_t, std::size_t>> children;
+            for(const std::pair<std::size_t, std::size_t>& range : ranges)
+            {
+                std::size_t mid = range.first + (range.second - range.first) / 2;
+                children.push_back({ range.first, mid });
+                children.push_back({ mid, range.second });
+            }
+            ranges = std::move(children);
+        }
+
+        Vector3SoA<T> sorted =
+        {
+            reinterpret_cast<T*>(data + offsets[2]),
+            reinterpret_cast<T*>(data + offsets[3]),
+            reinterpret_cast<T*>(data + offsets[4]),
+            source.size
+        };
+        Parallel::For(source.size, 1 << 14, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                sorted.x[i] = source.x[order[i]];
+                sorted.y[i] = source.y[order[i]];
+                sorted.z[i] = source.z[order[i]];
+            }
+        }, execution);
+
+        Attach(storage.Component(0), storage.Size());
+    }
+
+    template<typename T>
+    std::size_t KdTree3<T>::ImageLayout(std::size_t size, std::size_t depth, std::array<std::size_t, 7>& offsets) noexcept
+    {
+        auto align = [](std::size_t offset)
+        {
+            return (offset + image_alignment - 1) / image_alignment * image_alignment;
+        };
+        std::size_t internal = (std::size_t{1} << depth) - 1;
+        offsets[0] = align(sizeof(Header));                                 // split values
+        offsets[1] = align(offsets[0] + internal * sizeof(T));              // split axes
+        offsets[2] = align(offsets[1] + internal * sizeof(std::uint8_t));   // x
+        offsets[3] = align(offsets[2] + size * sizeof(T));                  // y
+        offsets[4] = align(offsets[3] + size * sizeof(T));                  // z
+        offsets[5] = align(offsets[4] + size * sizeof(T));                  // original indices
+        offsets[6] = align(offsets[5] + size * sizeof(std::uint32_t));      // end
+        return offsets[6];
+    }
+
+    template<typename T>
+    void KdTree3<T>::Attach(const unsigned char* data, std::size_t data_size)
+    {
+        if(data_size < sizeof(Header))
+        {
+            throw std::runtime_error("kd tree image is too small");
+        }
+        if(reinterpret_cast<std::uintptr_t>(data) % alignof(std::max_align_t) != 0)
+        {
+            throw std::runtime_error("kd tree image is not aligned");
+        }
+
+        Header header;
+        std::memcpy(&header, data, sizeof(Header));
+        if(std::memcmp(header.magic, "LKD3", 4) != 0 || header.version != image_version)
+        {
+            throw std::runtime_error("not a kd tree image");
+        }
+        if(header.scalar_size != sizeof(T))
+        {
+            throw std::runtime_error("kd tree image has another scalar type");
+        }
+        if(header.depth >= 32 || header.size >= npos)
+        {
+            throw std::runtime_error("kd tree image is corrupted");
+        }
+        // queries keep the distances of one leaf on the stack
+        std::uint64_t leaf_size = (header.size + (std::uint64_t{1} << header.depth) - 1) >> header.depth;
+        if(header.bucket_size == 0 || header.bucket_size > max_bucket_size || leaf_size > header.bucket_size)
+        {
+            throw std::runtime_error("kd tree image is corrupted");
+        }
+
+        std::array<std::size_t, 7> offsets;
+        if(ImageLayout(header.size, header.depth, offsets) > data_size)
+        {
+            throw std::runtime_error("kd tree image is too small");
+        }
+
+        image = data;
+        image_size = offsets[6];
+        size = header.size;
+        depth = header.depth;
+        bucket_size = header.bucket_size;
+        split = reinterpret_cast<const T*>(data + offsets[0]);
+        axis = reinterpret_cast<const std::uint8_t*>(data + offsets[1]);
+        points =
+        {
+            reinterpret_cast<const T*>(data + offsets[2]),
+            reinterpret_cast<const T*>(data + offsets[3]),
+            reinterpret_cast<const T*>(data + offsets[4]),
+            size
+        };
+        index = reinterpret_cast<const std::uint32_t*>(data + offsets[5]);
+    }
+
+    template<typename T>
+    void KdTree3<T>::Split(Vector3SoA<const T> source, std::uint32_t* order, T* split_out, std::uint8_t* axis_out,
+        std::size_t node, std::size_t begin, std::size_t end) const
+    {
+        if(begin == end)
+        {
+            split_out[node] = 0;
+            axis_out[node] = 0;
+            return;
+        }
+
+        // split along the longest side of the bounding box
+        Vector3<T> low = source.Get(order[begin]);
+        Vector3<T> high = low;
+        for(std::size_t i = begin + 1; i < end; ++i)
+        {
+            Vector3<T> point = source.Get(order[i]);
+            low = { std::min(low.x, point.x), std::min(low.y, point.y), std::min(low.z, point.z) };
+            high = { std::max(high.x, point.x), std::max(high.y, point.y), std::max(high.z, point.z) };
+        }
+        Vector3<T> extent = high - low;
+        std::uint8_t split_axis = extent.x >= extent.y ? (extent.x >= extent.z ? 0 : 2) : (extent.y >= extent.z ? 1 : 2);
+        const T* coordinate = split_axis == 0 ? source.x : (split_axis == 1 ? source.y : source.z);
+
+        std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(order + begin, order + mid, order + end, [coordinate](std::uint32_t a, std::uint32_t b)
+        {
+            return coordinate[a] < coordinate[b];
+        });
+        split_out[node] = coordinate[order[mid]];
+        axis_out[node] = split_axis;
+    }
+
+    template<typename T>
+    void KdTree3<T>::Build(Vector3SoA<const T> source, std::uint32_t* order, T* split_out, std::uint8_t* axis_out,
+        std::size_t node, std::size_t begin, std::size_t end, std::size_t level) const
+    {
+        if(level == depth)
+        {
+            return;
+        }
+        Split(source, order, split_out, axis_out, node, begin, end);
+        std::size_t mid = begin + (end - begin) / 2;
+        Build(source, order, split_out, axis_out, 2 * node + 1, begin, mid, level + 1);
+        Build(source, order, split_out, axis_out, 2 * node + 2, mid, end, level + 1);
+    }
+
+    template<typename T>
+    std::size_t KdTree3<T>::Size() const noexcept
+    {
+        return size;
+    }
+
+    template<typename T>
+    void KdTree3<T>::Nearest(const Vector3<T>& query, std::size_t k, std::uint32_t* indices, T* distances2) const noexcept
+    {
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            indices[i] = npos;
+            distances2[i] = std::numeric_limits<T>::infinity();
+        }
+        if(k == 0 || size == 0)
+        {
+            return;
+        }
+
+        struct Entry
+        {
+            std::size_t node;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t level;
+            T plane2;
+        };
+        Entry stack[64];
+        std::size_t top = 0;
+        stack[top++] = { 0, 0, size, 0, T(0) };
+
+        const T q[3] = { query.x, query.y, query.z };
+        T leaf_distances[max_bucket_size];
+
+        while(top != 0)
+        {
+            Entry entry = stack[--top];
+            if(entry.plane2 > distances2[k - 1])
+            {
+                continue;
+            }
+
+            if(entry.level == depth)
+            {
+                std::size_t count = entry.end - entry.begin;
+                const T* x = points.x + entry.begin;
+                const T* y = points.y + entry.begin;
+                const T* z = points.z + entry.begin;
+                // no dependencies between lanes, vectorized
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    T dx = x[i] - q[0];
+                    T dy = y[i] - q[1];
+                    T dz = z[i] - q[2];
+                    leaf_distances[i] = dx * dx + dy * dy + dz * dz;
+                }
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    if(leaf_distances[i] >= distances2[k - 1])
+                    {
+                        continue;
+                    }
+                    // insertion into the sorted result
+                    std::size_t slot = k - 1;
+                    while(slot != 0 && distances2[slot - 1] > leaf_distances[i])
+                    {
+                        distances2[slot] = distances2[slot - 1];
+                        indices[slot] = indices[slot - 1];
+                        --slot;
+                    }
+                    distances2[slot] = leaf_distances[i];
+                    indices[slot] = index[entry.begin + i];
+                }
+                continue;
+            }
+
+            std::size_t mid = entry.begin + (entry.end - entry.begin) / 2;
+            T diff = q[axis[entry.node]] - split[entry.node];
+            Entry left = { 2 * entry.node + 1, entry.begin, mid, entry.level + 1, T(0) };
+            Entry right = { 2 * entry.node + 2, mid, entry.end, entry.level + 1, T(0) };
+            // the far side goes first, so the near side is popped first
+            if(diff < 0)
+            {
+                right.plane2 = diff * diff;
+                stack[top++] = right;
+                stack[top++] = left;
+            }
+            else
+            {
+                left.plane2 = diff * diff;
+                stack[top++] = left;
+                stack[top++] = right;
+            }
+        }
+    }
+
+    template<typename T>
+    void KdTree3<T>::Nearest(Vector3SoA<const T> queries, std::size_t k, std::uint32_t* indices, T* distances2, const Execution& execution) const
+    {
+        Parallel::For(queries.size, 256, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                Nearest(queries.Get(i), k, indices + i * k, distances2 + i * k);
+            }
+        }, execution);
+    }
+
+    template<typename T>
+    void KdTree3<T>::Radius(const Vector3<T>& query, const T& radius, std::vector<std::uint32_t>& indices) const
+    {
+        if(size == 0)
+        {
+            return;
+        }
+
+        struct Entry
+        {
+            std::size_t node;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t level;
+        };
+        Entry stack[64];
+        std::size_t top = 0;
+        stack[top++] = { 0, 0, size, 0 };
+
+        const T q[3] = { query.x, query.y, query.z };
+        const T radius2 = radius * radius;
+        T leaf_distances[max_bucket_size];
+
+        while(top != 0)
+        {
+            Entry entry = stack[--top];
+            if(entry.level == depth)
+            {
+                std::size_t count = entry.end - entry.begin;
+                const T* x = points.x + entry.begin;
+                const T* y = points.y + entry.begin;
+                const T* z = points.z + entry.begin;
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    T dx = x[i] - q[0];
+                    T dy = y[i] - q[1];
+                    T dz = z[i] - q[2];
+                    leaf_distances[i] = dx * dx + dy * dy + dz * dz;
+                }
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    if(leaf_distances[i] <= radius2)
+                    {
+                        indices.push_back(index[entry.begin + i]);
+                    }
+                }
+                continue;
+            }
+
+            std::size_t mid = entry.begin + (entry.end - entry.begin) / 2;
+            T diff = q[axis[entry.node]] - split[entry.node];
+            if(diff <= radius)
+            {
+                stack[top++] = { 2 * entry.node + 1, entry.begin, mid, entry.level + 1 };
+            }
+            if(diff >= -radius)
+            {
+                stack[top++] = { 2 * entry.node + 2, mid, entry.end, entry.level + 1 };
+            }
+        }
+    }
+
+    template<typename T>
+    void KdTree3<T>::Radius(Vector3SoA<const T> queries, const T& radius, std::vector<std::size_t>& offsets, std::vector<std::uint32_t>& indices, const Execution& execution) const
+    {
+        // every chunk collects its own results in one buffer, chunk bounds are multiples of the grain so begin / grain numbers them.
+        // chunks are concatenated in order so the output does not depend on threads
+        const std::size_t grain = 256;
+        std::vector<std::vector<std::uint32_t>> chunk_indices((queries.size + grain - 1) / grain);
+        offsets.assign(queries.size + 1, 0);
+        Parallel::For(queries.size, grain, [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<std::uint32_t>& found = chunk_indices[begin / grain];
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t before = found.size();
+                Radius(queries.Get(i), radius, found);
+                offsets[i + 1] = found.size() - before;
+            }
+        }, execution);
+
+        for(std::size_t i = 0; i < queries.size; ++i)
+        {
+            offsets[i + 1] += offsets[i];
+        }
+        indices.clear();
+        indices.reserve(offsets[queries.size]);
+        for(const std::vector<std::uint32_t>& found : chunk_indices)
+        {
+            indices.insert(indices.end(), found.begin(), found.end());
+        }
+    }
+
+    template<typename T>
+    const unsigned char* KdTree3<T>::ImageData() const noexcept
+    {
+        return image;
+    }
+
+    template<typename T>
+    std::size_t KdTree3<T>::ImageSize() const noexcept
+    {
+        return image_size;
+    }
+
+    template<typename T>
+    KdTree3<T> KdTree3<T>::View(const void* data, std::size_t data_size)
+    {
+        KdTree3<T> tree;
+        tree.Attach(static_cast<const unsigned char*>(data), data_size);
+        return tree;
+    }
+
+    template<typename T>
+    KdTree3<T> KdTree3<T>::Load(const void* data, std::size_t data_size, std::pmr::memory_resource* resource)
+    {
+        KdTree3<T> tree;
+        tree.storage = SoABuffer<unsigned char, 1>(data_size, resource);
+        std::memcpy(tree.storage.Component(0), data, data_size);
+        tree.Attach(tree.storage.Component(0), tree.storage.Size());
+        return tree;
+    }
+} // namespace linal
@@ -0,0 +1,250 @@
+#pragma once
+#include "Linal.h"
+#include <cmath>
+#include <cstring>
+
+namespace linal
+{
+
+    template<typename T>
+    T StdMath<T>::Sqrt(const T& x) const noexcept
+    {
+        return std::sqrt(x);
+    }
+
+    template<typename T>
+    T StdMath<T>::Exp(const T& x) const noexcept
+    {
+        return std::exp(x);
+    }
+
+    template<typename T>
+    T StdMath<T>::Log(const T& x) const noexcept
+    {
+        return std::log(x);
+    }
+
+    template<typename T>
+    T StdMath<T>::Sin(const T& x) const noexcept
+    {
+        return std::sin(x);
+    }
+
+    template<typename T>
+    T StdMath<T>::Cos(const T& x) const noexcept
+    {
+        return std::cos(x);
+    }
+
+    template<typename T>
+    T StdMath<T>::Atan2(const T& y, const T& x) const noexcept
+    {
+        return std::atan2(y, x);
+    }
+
+    template<typename T>
+    T StdMath<T>::RSqrt(const T& x) const noexcept
+    {
+        return T(1) / std::sqrt(x);
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    T FastMath<T>::Sqrt(const T& x) const noexcept
+    {
+        // a single instruction on every target with vector units
+        return std::sqrt(x);
+    }
+
+    template<typename T>
+    T FastMath<T>::Pow2(Bits exponent) noexcept
+    {
+        const Bits bits = (exponent + exponent_bias) << mantissa_bits;
+        T result;
+        std::memcpy(&result, &bits, sizeof(T));
+        return result;
+    }
+
+    template<typename T>
+    T FastMath<T>::Exp(const T& x) const noexcept
+    {
+        const T log2e = T(1.44269504088896340736L);
+        // ln(2) split so that k * ln2_hi is exact
+        const T ln2_hi = T(0.693145751953125L);
+        const T ln2_lo = T(1.42860682030941723212e-6L);
+        // log of the largest finite value
+        const T max_x = sizeof(T) == 4 ? T(88.7228391116729996L) : T(709.782712893383973096L);
+        const T min_x = T(std::numeric_limits<T>::min_exponent - 1) * T(0.693147180559945309417L);
+
+        // x = k * ln(2) + r with |r| <= ln(2) / 2. k is clamped before the scaling, out of range x are selected at the end.
+        // nan goes through r
+        const T min_k = T(std::numeric_limits<T>::min_exponent - 1);
+        const T max_k = T(std::numeric_limits<T>::max_exponent);
+        T scaled = x * log2e;
+        scaled = !(scaled >= min_k) ? min_k : scaled;
+        scaled = scaled > max_k ? max_k : scaled;
+        // rounded through a positive offset, a sign select here would let the compiler split the loop body on x
+        const Bits offset = 2 * std::numeric_limits<T>::max_exponent;
+        const Bits k = static_cast<Bits>(scaled + T(offset) + T(0.5)) - offset;
+        const T k_real = T(k);
+        const T r = (x - k_real * ln2_hi) - k_real * ln2_lo;
+
+        const T p = T(1) + r * (T(1) + r * (T(1.0L / 2) + r * (T(1.0L / 6) + r * (T(1.0L / 24) + r * (T(1.0L / 120)
+            + r * (T(1.0L / 720) + r * (T(1.0L / 5040) + r * T(1.0L / 40320))))))));
+        // 2^k in two normal halves, k = max_exponent just below the overflow has no normal power of its own
+        const Bits half_k = k / 2;
+        T result = p * Pow2(half_k) * Pow2(k - half_k);
+
+        result = x < min_x ? T(0) : result;
+        return x > max_x ? std::numeric_limits<T>::infinity() : result;
+    }
+
+    template<typename T>
+    T FastMath<T>::Log(const T& x) const noexcept
+    {
+        const T sqrt_2 = T(1.41421356237309504880L);
+        const T ln2_hi = T(0.693145751953125L);
+        const T ln2_lo = T(1.42860682030941723212e-6L);
+        const Bits exponent_mask = (Bits(1) << (sizeof(T) * CHAR_BIT - 1 - mantissa_bits)) - 1;
+        const Bits mantissa_mask = (Bits(1) << mantissa_bits) - 1;
+
+        // subnormals are scaled into the normal range first
+        const bool tiny = x < std::numeric_limits<T>::min();
+        const T boosted = x * T(Bits(1) << std::numeric_limits<T>::digits);
+        const T normal = tiny ? boosted : x;
+
+        // x = m * 2^e with m in [sqrt(0.5), sqrt(2))
+        Bits bits;
+        std::memcpy(&bits, &normal, sizeof(T));
+        Bits e = ((bits >> mantissa_bits) & exponent_mask) - exponent_bias;
+        bits = (bits & mantissa_mask) | (Bits(exponent_bias) << mantissa_bits);
+        T m;
+        std::memcpy(&m, &bits, sizeof(T));
+        const bool high = m > sqrt_2;
+        const T half = m * T(0.5);
+        m = high ? half : m;
+        e = e + (high ? 1 : 0) - (tiny ? std::numeric_limits<T>::digits : 0);
+
+        // log(m) = 2 * atanh(s), |s| <= 0.1716
+        const T s = (m - T(1)) / (m + T(1));
+        const T s2 = s * s;
+        const T log_m = T(2) * s * (T(1) + s2 * (T(1.0L / 3) + s2 * (T(1.0L / 5) + s2 * (T(1.0L / 7) + s2 * (T(1.0L / 9)
+            + s2 * T(1.0L / 11))))));
+        const T e_real = T(e);
+        const T result = e_real * ln2_hi + (log_m + e_real * ln2_lo);
+
+        const T infinity = std::numeric_limits<T>::infinity();
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        return x > 0 ? (x == infinity ? infinity : result) : (x == 0 ? -infinity : nan);
+    }
+
+    template<typename T>
+    T FastMath<T>::Reduce(const T& x, Bits& quadrant) noexcept
+    {
+        const T two_over_pi = T(0.636619772367581343076L);
+        // tau / 4 in three parts, the first two are short enough for exact products with the quadrant
+        const T pio2_1 = T(1.5703125L);
+        const T pio2_2 = T(4.837512969970703125e-4L);
+        const T pio2_3 = T(7.54978995489188216e-8L);
+        const T limit = T(Bits(1) << 30);
+
+        // nan, infinity and arguments beyond the limit never reach the conversion, their reduced argument is nan
+        T scaled = x * two_over_pi;
+        const bool reducible = scaled >= -limit && scaled <= limit;
+        scaled = reducible ? scaled : T(0);
+        quadrant = static_cast<Bits>(scaled + (scaled < 0 ? T(-0.5) : T(0.5)));
+        const T q = T(quadrant);
+        const T r = ((x - q * pio2_1) - q * pio2_2) - q * pio2_3;
+        return reducible ? r : std::numeric_limits<T>::quiet_NaN();
+    }
+
+    template<typename T>
+    T FastMath<T>::SinPolynomial(const T& r) noexcept
+    {
+        const T r2 = r * r;
+        return r + r * r2 * (T(-1.0L / 6) + r2 * (T(1.0L / 120) + r2 * (T(-1.0L / 5040) + r2 * (T(1.0L / 362880)
+            + r2 * (T(-1.0L / 39916800) + r2 * T(1.0L / 6227020800))))));
+    }
+
+    template<typename T>
+    T FastMath<T>::CosPolynomial(const T& r) noexcept
+    {
+        const T r2 = r * r;
+        return T(1) + r2 * (T(-1.0L / 2) + r2 * (T(1.0L / 24) + r2 * (T(-1.0L / 720) + r2 * (T(1.0L / 40320)
+            + r2 * (T(-1.0L / 3628800) + r2 * T(1.0L / 479001600))))));
+    }
+
+    template<typename T>
+    T FastMath<T>::Sin(const T& x) const noexcept
+    {
+        Bits quadrant;
+        const T r = Reduce(x, quadrant);
+        const T s = SinPolynomial(r);
+        const T c = CosPolynomial(r);
+        const T value = (quadrant & 1) ? c : s;
+        return (quadrant & 2) ? -value : value;
+    }
+
+    template<typename T>
+    T FastMath<T>::Cos(const T& x) const noexcept
+    {
+        // cos(x) = sin(x + tau / 4)
+        Bits quadrant;
+        const T r = Reduce(x, quadrant);
+        quadrant = quadrant + 1;
+        const T s = SinPolynomial(r);
+        const T c = CosPolynomial(r);
+        const T value = (quadrant & 1) ? c : s;
+        return (quadrant & 2) ? -value : value;
+    }
+
+    template<typename T>
+    T FastMath<T>::Atan2(const T& y, const T& x) const noexcept
+    {
+        const T pi = T(tau / 2);
+        const T tan_pi_8 = T(0.414213562373095048802L);
+
+        const T ax = x < 0 ? -x : x;
+        const T ay = y < 0 ? -y : y;
+        const T high = ax > ay ? ax : ay;
+        const T low = ax > ay ? ay : ax;
+        const T a = low / (high > 0 ? high : T(1));
+
+        // atan(a) = tau / 8 + atan((a - 1) / (a + 1)), so the series only sees |t| <= tan(tau / 16)
+        const bool upper = a > tan_pi_8;
+        const T shifted = (a - T(1)) / (a + T(1));
+        const T t = upper ? shifted : a;
+        const T t2 = t * t;
+        const T p = t + t * t2 * (T(-1.0L / 3) + t2 * (T(1.0L / 5) + t2 * (T(-1.0L / 7) + t2 * (T(1.0L / 9) + t2 * (T(-1.0L / 11)
+            + t2 * (T(1.0L / 13) + t2 * (T(-1.0L / 15) + t2 * (T(1.0L / 17) + t2 * T(-1.0L / 19)))))))));
+
+        T angle = upper ? pi / 4 + p : p;
+        angle = ay > ax ? pi / 2 - angle : angle;
+        angle = x < 0 ? pi - angle : angle;
+        return y < 0 ? -angle : angle;
+    }
+
+    template<typename T>
+    T FastMath<T>::RSqrt(const T& x) const noexcept
+    {
+        // the guess is within 3.5%, every newton step squares the error
+        const Bits magic = static_cast<Bits>(sizeof(T) == 4 ? 0x5f375a86LL : 0x5fe6eb50c7b537a9LL);
+        const int steps = sizeof(T) == 4 ? 3 : 4;
+        Bits bits;
+        std::memcpy(&bits, &x, sizeof(T));
+        bits = magic - (bits >> 1);
+        T y;
+        std::memcpy(&y, &bits, sizeof(T));
+        const T half_x = x * T(0.5);
+        for(int step = 0; step < steps; ++step)
+        {
+            y = y * (T(1.5) - half_x * y * y);
+        }
+
+        const T infinity = std::numeric_limits<T>::infinity();
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        return x > 0 ? (x == infinity ? T(0) : y) : (x == 0 ? infinity : nan);
+    }
+
+} // namespace linal
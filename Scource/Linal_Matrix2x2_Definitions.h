@@ -1,5 +1,6 @@
 #pragma once
 #include "Linal.h"
+#include <cmath>
 
 namespace linal
 {
@@ -133,6 +134,15 @@ namespace linal
         };
     }
 
+    template<typename T>
+    std::pair<Vector2<T>, bool> Matrix2x2<T>::Solve(const Vector2<T>& b, const T& regularization) const noexcept
+    {
+        Vector2<T> x;
+        std::uint8_t solved;
+        SolveLane(line0.x, line0.y, line1.x, line1.y, b.x, b.y, regularization, x.x, x.y, solved);
+        return {x, solved != 0};
+    }
+
     template <typename T>
     const Matrix2x2<T> Matrix2x2<T>::one = 
     {
@@ -207,4 +217,225 @@ namespace linal
     }
 
 
+    template<typename T>
+    void Matrix2x2<T>::HalfAngleLane(const T& re, const T& im, T& half_re, T& half_im) noexcept
+    {
+        // (|z| + re, im) and (im, |z| - re) both point at half of the angle (up to a half turn),
+        // the one far from zero is taken
+        const T abs = std::sqrt(re * re + im * im);
+        const bool right = re >= 0;
+        const T x = right ? abs + re : im;
+        const T y = right ? im : abs - re;
+        const T length2 = x * x + y * y;
+        const bool valid = length2 > 0;
+        const T inv = T(1) / std::sqrt(valid ? length2 : T(1));
+        half_re = valid ? x * inv : T(1);
+        half_im = valid ? y * inv : T(0);
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::EigenSymmetricLane(
+        const T& xx, const T& xy, const T& yy,
+        T& value0, T& value1, T& re, T& im) noexcept
+    {
+        const T mean = (xx + yy) / 2;
+        const T half_diff = (xx - yy) / 2;
+        const T radius = std::sqrt(half_diff * half_diff + xy * xy);
+        value0 = mean + radius;
+        value1 = mean - radius;
+        // the first eigen vector is at half of the angle of (half_diff, xy)
+        HalfAngleLane(half_diff, xy, re, im);
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::PolarDecompositionLane(
+        const T& xx, const T& xy, const T& yx, const T& yy,
+        T& re, T& im, T& sxx, T& sxy, T& syy) noexcept
+    {
+        // the closest rotation maximizes trace(R^T * A), its direction is (xx + yy, yx - xy)
+        const T x = xx + yy;
+        const T y = yx - xy;
+        const T length2 = x * x + y * y;
+        const bool valid = length2 > 0;
+        const T inv = T(1) / std::sqrt(valid ? length2 : T(1));
+        re = valid ? x * inv : T(1);
+        im = valid ? y * inv : T(0);
+
+        // stretch = R^T * A
+        sxx = re * xx + im * yx;
+        sxy = re * xy + im * yy;
+        syy = re * yy - im * xy;
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::SVDLane(
+        const T& xx, const T& xy, const T& yx, const T& yy,
+        T& u_re, T& u_im, T& sigma0, T& sigma1, T& v_re, T& v_im) noexcept
+    {
+        // A is a scaled rotation (e, h) plus a scaled reflection (f, g)
+        const T e = (xx + yy) / 2;
+        const T f = (xx - yy) / 2;
+        const T g = (yx + xy) / 2;
+        const T h = (yx - xy) / 2;
+        const T q = std::sqrt(e * e + h * h);
+        const T r = std::sqrt(f * f + g * g);
+        sigma0 = q + r;
+        sigma1 = q - r;
+
+        // unit directions of both parts, any direction if the part is zero
+        const T rot_re = q > 0 ? e / (q > 0 ? q : T(1)) : T(1);
+        const T rot_im = q > 0 ? h / (q > 0 ? q : T(1)) : T(0);
+        const T ref_re = r > 0 ? f / (r > 0 ? r : T(1)) : T(1);
+        const T ref_im = r > 0 ? g / (r > 0 ? r : T(1)) : T(0);
+
+        // u has the mean angle of both parts and v^T the rest of the rotation part
+        HalfAngleLane(rot_re * ref_re - rot_im * ref_im, rot_re * ref_im + rot_im * ref_re, u_re, u_im);
+        const T vt_re = rot_re * u_re + rot_im * u_im;
+        const T vt_im = rot_im * u_re - rot_re * u_im;
+        v_re = vt_re;
+        v_im = -vt_im;
+    }
+
+    template<typename T>
+    std::pair<Vector2<T>, Rotator2<T>> Matrix2x2<T>::EigenSymmetric() const noexcept
+    {
+        Vector2<T> values;
+        Complex<T> basis;
+        EigenSymmetricLane(line0.x, line0.y, line1.y, values.x, values.y, basis.re, basis.im);
+        return { values, Rotator2<T>(basis) };
+    }
+
+    template<typename T>
+    std::pair<Rotator2<T>, Matrix2x2<T>> Matrix2x2<T>::PolarDecomposition() const noexcept
+    {
+        Complex<T> rotation;
+        Matrix2x2<T> stretch;
+        PolarDecompositionLane(line0.x, line0.y, line1.x, line1.y, rotation.re, rotation.im, stretch.line0.x, stretch.line0.y, stretch.line1.y);
+        stretch.line1.x = stretch.line0.y;
+        return { Rotator2<T>(rotation), stretch };
+    }
+
+    template<typename T>
+    std::tuple<Rotator2<T>, Vector2<T>, Rotator2<T>> Matrix2x2<T>::SVD() const noexcept
+    {
+        Complex<T> u;
+        Vector2<T> sigma;
+        Complex<T> v;
+        SVDLane(line0.x, line0.y, line1.x, line1.y, u.re, u.im, sigma.x, sigma.y, v.re, v.im);
+        return { Rotator2<T>(u), sigma, Rotator2<T>(v) };
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::EigenSymmetric(Matrix2x2SoA<const T> matrices, Vector2SoA<T> values, ComplexSoA<T> bases) noexcept
+    {
+        for(std::size_t i = 0; i < matrices.size; ++i)
+        {
+            EigenSymmetricLane(matrices.xx[i], matrices.xy[i], matrices.yy[i], values.x[i], values.y[i], bases.re[i], bases.im[i]);
+        }
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::PolarDecomposition(Matrix2x2SoA<const T> matrices, ComplexSoA<T> rotations, Matrix2x2SoA<T> stretches) noexcept
+    {
+        for(std::size_t i = 0; i < matrices.size; ++i)
+        {
+            T sxy;
+            PolarDecompositionLane(matrices.xx[i], matrices.xy[i], matrices.yx[i], matrices.yy[i],
+                rotations.re[i], rotations.im[i], stretches.xx[i], sxy, stretches.yy[i]);
+            stretches.xy[i] = sxy;
+            stretches.yx[i] = sxy;
+        }
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::SVD(Matrix2x2SoA<const T> matrices, ComplexSoA<T> u, Vector2SoA<T> sigma, ComplexSoA<T> v) noexcept
+    {
+        for(std::size_t i = 0; i < matrices.size; ++i)
+        {
+            SVDLane(matrices.xx[i], matrices.xy[i], matrices.yx[i], matrices.yy[i],
+                u.re[i], u.im[i], sigma.x[i], sigma.y[i], v.re[i], v.im[i]);
+        }
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::EigenSymmetric(const Execution& execution, Matrix2x2SoA<const T> matrices, Vector2SoA<T> values, ComplexSoA<T> bases)
+    {
+        Parallel::For(matrices.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            EigenSymmetric(matrices.Slice(begin, end - begin), values.Slice(begin, end - begin), bases.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::PolarDecomposition(const Execution& execution, Matrix2x2SoA<const T> matrices, ComplexSoA<T> rotations, Matrix2x2SoA<T> stretches)
+    {
+        Parallel::For(matrices.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            PolarDecomposition(matrices.Slice(begin, end - begin), rotations.Slice(begin, end - begin), stretches.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::SVD(const Execution& execution, Matrix2x2SoA<const T> matrices, ComplexSoA<T> u, Vector2SoA<T> sigma, ComplexSoA<T> v)
+    {
+        Parallel::For(matrices.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            SVD(matrices.Slice(begin, end - begin), u.Slice(begin, end - begin), sigma.Slice(begin, end - begin), v.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::SolveLane(
+        const T& xx, const T& xy, const T& yx, const T& yy,
+        const T& b_x, const T& b_y, const T& regularization,
+        T& x, T& y, std::uint8_t& solved) noexcept
+    {
+        // x * m == b is m transposed times the column x
+        const T a = xx + regularization;
+        const T d = yy + regularization;
+        const T ad = a * d;
+        const T bc = xy * yx;
+        const T det = ad - bc;
+        const T abs_det = det < 0 ? -det : det;
+        const T scale = (ad < 0 ? -ad : ad) + (bc < 0 ? -bc : bc);
+        // also false for nan
+        const bool valid = abs_det > std::numeric_limits<T>::epsilon() * scale;
+        const T inv = T(1) / (valid ? det : T(1));
+        x = valid ? (b_x * d - yx * b_y) * inv : T(0);
+        y = valid ? (a * b_y - xy * b_x) * inv : T(0);
+        solved = valid ? 1 : 0;
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::Solve(Matrix2x2SoA<const T> matrices, Vector2SoA<const T> b, Vector2SoA<T> x, std::uint8_t* solved,
+        const T& regularization) noexcept
+    {
+        for(std::size_t i = 0; i < matrices.size; ++i)
+        {
+            SolveLane(matrices.xx[i], matrices.xy[i], matrices.yx[i], matrices.yy[i], b.x[i], b.y[i], regularization,
+                x.x[i], x.y[i], solved[i]);
+        }
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::Solve(const Matrix2x2<T>* matrices, const Vector2<T>* b, Vector2<T>* x, std::uint8_t* solved, std::size_t count,
+        const T& regularization) noexcept
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const Matrix2x2<T>& m = matrices[i];
+            SolveLane(m.line0.x, m.line0.y, m.line1.x, m.line1.y, b[i].x, b[i].y, regularization, x[i].x, x[i].y, solved[i]);
+        }
+    }
+
+    template<typename T>
+    void Matrix2x2<T>::Solve(const Execution& execution, Matrix2x2SoA<const T> matrices, Vector2SoA<const T> b, Vector2SoA<T> x,
+        std::uint8_t* solved, const T& regularization)
+    {
+        Parallel::For(matrices.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Solve(matrices.Slice(begin, end - begin), b.Slice(begin, end - begin), x.Slice(begin, end - begin), solved + begin, regularization);
+        }, execution);
+    }
+
 } // namespace linal
\ No newline at end of file
@@ -0,0 +1,356 @@
+#pragma once
+#include "Linal.h"
+#include <cmath>
+#include <algorithm>
+
+namespace linal
+{
+    template<typename T>
+    Matrix3x3<T>& Matrix3x3<T>::operator+=(const Matrix3x3<T>& other) noexcept
+    {
+        line0 += other.line0;
+        line1 += other.line1;
+        line2 += other.line2;
+        return *this;
+    }
+
+    template<typename T>
+    Matrix3x3<T>& Matrix3x3<T>::operator-=(const Matrix3x3<T>& other) noexcept
+    {
+        line0 -= other.line0;
+        line1 -= other.line1;
+        line2 -= other.line2;
+        return *this;
+    }
+
+    template<typename T>
+    Matrix3x3<T>& Matrix3x3<T>::operator*=(const T& scalar) noexcept
+    {
+        line0 *= scalar;
+        line1 *= scalar;
+        line2 *= scalar;
+        return *this;
+    }
+
+    template<typename T>
+    Matrix3x3<T>& Matrix3x3<T>::operator/=(const T& scalar)
+    {
+        if(scalar == 0)
+        {
+            throw std::runtime_error("devision by zero");
+        }
+
+        line0 /= scalar;
+        line1 /= scalar;
+        line2 /= scalar;
+        return *this;
+    }
+
+    template<typename T>
+    Matrix3x3<T>& Matrix3x3<T>::operator*=(const Matrix3x3<T>& other) noexcept
+    {
+        return *this = *this * other;
+    }
+
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::operator-() const noexcept
+    {
+        return { -line0, -line1, -line2 };
+    }
+
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::operator+(const Matrix3x3<T>& other) const noexcept
+    {
+        return Matrix3x3<T>(*this) += other;
+    }
+
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::operator-(const Matrix3x3<T>& other) const noexcept
+    {
+        return Matrix3x3<T>(*this) -= other;
+    }
+
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::operator*(const T& scalar) const noexcept
+    {
+        return Matrix3x3<T>(*this) *= scalar;
+    }
+
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::operator/(const T& scalar) const
+    {
+        return Matrix3x3<T>(*this) /= scalar;
+    }
+
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::operator*(const Matrix3x3<T>& other) const noexcept
+    {
+        Matrix3x3<T> other_t = other.Transposed();
+        return
+        {
+            { line0.Dot(other_t.line0), line0.Dot(other_t.line1), line0.Dot(other_t.line2) },
+            { line1.Dot(other_t.line0), line1.Dot(other_t.line1), line1.Dot(other_t.line2) },
+            { line2.Dot(other_t.line0), line2.Dot(other_t.line1), line2.Dot(other_t.line2) }
+        };
+    }
+
+    template<typename T>
+    bool Matrix3x3<T>::operator==(const Matrix3x3<T>& other) const noexcept
+    {
+        return (line0 == other.line0) && (line1 == other.line1) && (line2 == other.line2);
+    }
+
+    template<typename T>
+    bool Matrix3x3<T>::operator!=(const Matrix3x3<T>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    template<typename T>
+    bool Matrix3x3<T>::Compare(const Matrix3x3<T>& other, const T& epsilon2) const noexcept
+    {
+        Matrix3x3<T> temp = *this - other;
+        return temp.line0.Abs2() + temp.line1.Abs2() + temp.line2.Abs2() < epsilon2;
+    }
+
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::Transposed() const noexcept
+    {
+        return
+        {
+            { line0.x, line1.x, line2.x },
+            { line0.y, line1.y, line2.y },
+            { line0.z, line1.z, line2.z }
+        };
+    }
+
+    template<typename T>
+    T Matrix3x3<T>::Det() const noexcept
+    {
+        return line0.Dot(line1.Cross(line2));
+    }
+
+    // Inverse
+    template<typename T>
+    Matrix3x3<T> Matrix3x3<T>::Inversed() const
+    {
+        T det = Det();
+        if (det == 0)
+        {
+            throw std::runtime_error("can't invert matrix with det == 0");
+        }
+        // columns of the inverse are cross products of the lines
+        return Matrix3x3<T>
+        {
+            line1.Cross(line2),
+            line2.Cross(line0),
+            line0.Cross(line1)
+        }.Transposed() /= det;
+    }
+
+    template <typename T>
+    const Matrix3x3<T> Matrix3x3<T>::one =
+    {
+        { 1, 0, 0 },
+        { 0, 1, 0 },
+        { 0, 0, 1 }
+    };
+
+    template <typename T>
+    const Matrix3x3<T> Matrix3x3<T>::zero =
+    {
+        { 0, 0, 0 },
+        { 0, 0, 0 },
+        { 0, 0, 0 }
+    };
+
+    template<typename T>
+    Transform3dUniform<T> Matrix3x3<T>::MakeTransform3D(const Vector3<T>& offset) const noexcept
+    {
+        Transform3dUniform<T> transform;
+        transform[0] = line0.x;
+        transform[1] = line0.y;
+        transform[2] = line0.z;
+        transform[3] = 0;
+        transform[4] = line1.x;
+        transform[5] = line1.y;
+        transform[6] = line1.z;
+        transform[7] = 0;
+        transform[8] = line2.x;
+        transform[9] = line2.y;
+        transform[10] = line2.z;
+        transform[11] = 0;
+        transform[12] = offset.x;
+        transform[13] = offset.y;
+        transform[14] = offset.z;
+        transform[15] = 1;
+        return transform;
+    }
+
+    template<typename T>
+    std::pair<Matrix3x3<T>, Vector3<T>> Matrix3x3<T>::ReadTransform(const Transform3dUniform<T>& transform) noexcept
+    {
+        Matrix3x3<T> matrix;
+        matrix.line0 = {transform[0], transform[1], transform[2]};
+        matrix.line1 = {transform[4], transform[5], transform[6]};
+        matrix.line2 = {transform[8], transform[9], transform[10]};
+        Vector3<T> offset = {transform[12], transform[13], transform[14]};
+        return {matrix, offset};
+    }
+
+    template<typename T>
+    template<std::size_t lanes>
+    void Matrix3x3<T>::EigenSymmetricLanes(T (&a)[6][lanes], T (&q)[4][lanes], std::size_t sweeps) noexcept
+    {
+        // position of element (i, j) in a
+        constexpr std::size_t at[3][3] = { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } };
+        constexpr T sqrt_half = T(sqrt_05);
+
+        // q = q * (ch, sh * e_axis), every lane is independent
+        auto rotate = [&q](std::size_t l, std::size_t axis, const T& ch, const T& sh)
+        {
+            const std::size_t next = (axis + 1) % 3;
+            const std::size_t after = (axis + 2) % 3;
+            T v[3] = { q[1][l], q[2][l], q[3][l] };
+            T re = q[0][l] * ch - v[axis] * sh;
+            q[1 + axis][l] = q[0][l] * sh + v[axis] * ch;
+            q[1 + next][l] = v[next] * ch + v[after] * sh;
+            q[1 + after][l] = v[after] * ch - v[next] * sh;
+            q[0][l] = re;
+        };
+
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            q[0][l] = 1;
+            q[1][l] = 0;
+            q[2][l] = 0;
+            q[3][l] = 0;
+        }
+
+        for(std::size_t sweep = 0; sweep < sweeps; ++sweep)
+        {
+            // pairs (0, 1), (1, 2), (2, 0), the rotation of a pair is around the remaining axis
+            for(std::size_t p = 0; p < 3; ++p)
+            {
+                const std::size_t r = (p + 2) % 3;
+                const std::size_t k = (p + 1) % 3;
+                for(std::size_t l = 0; l < lanes; ++l)
+                {
+                    const T app = a[at[p][p]][l];
+                    const T aqq = a[at[k][k]][l];
+                    const T apq = a[at[p][k]][l];
+                    const T arp = a[at[r][p]][l];
+                    const T arq = a[at[r][k]][l];
+
+                    // tangent of the rotation angle, zero if the element is already zero
+                    const bool active = apq != 0;
+                    const T theta = (aqq - app) / (2 * (active ? apq : T(1)));
+                    const T t_abs = T(1) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                    const T t = active ? (theta < 0 ? -t_abs : t_abs) : T(0);
+                    const T c = T(1) / std::sqrt(t * t + 1);
+                    const T s = t * c;
+
+                    a[at[p][p]][l] = app - t * apq;
+                    a[at[k][k]][l] = aqq + t * apq;
+                    a[at[p][k]][l] = 0;
+                    a[at[r][p]][l] = c * arp - s * arq;
+                    a[at[r][k]][l] = s * arp + c * arq;
+
+                    // the jacobi rotation is a rotation by -angle around axis r, |angle| <= tau / 8
+                    const T ch = std::sqrt((1 + c) / 2);
+                    rotate(l, r, ch, -s / (2 * ch));
+                }
+            }
+        }
+
+        // sort descending, swapping columns i and i + 1 is a quarter turn around the third axis
+        constexpr std::size_t order[3] = { 0, 1, 0 };
+        for(std::size_t i : order)
+        {
+            const std::size_t next = i + 1;
+            for(std::size_t l = 0; l < lanes; ++l)
+            {
+                const bool swap = a[at[i][i]][l] < a[at[next][next]][l];
+                const T low = a[at[i][i]][l];
+                const T high = a[at[next][next]][l];
+                a[at[i][i]][l] = swap ? high : low;
+                a[at[next][next]][l] = swap ? low : high;
+
+                const T saved[4] = { q[0][l], q[1][l], q[2][l], q[3][l] };
+                rotate(l, (i + 2) % 3, sqrt_half, sqrt_half);
+                for(std::size_t c = 0; c < 4; ++c)
+                {
+                    q[c][l] = swap ? q[c][l] : saved[c];
+                }
+            }
+        }
+
+        // one sign for the same rotation, and the drift of the products is removed
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            const T sign = q[0][l] < 0 ? T(-1) : T(1);
+            const T scale = sign / std::sqrt(q[0][l] * q[0][l] + q[1][l] * q[1][l] + q[2][l] * q[2][l] + q[3][l] * q[3][l]);
+            for(std::size_t c = 0; c < 4; ++c)
+            {
+                q[c][l] *= scale;
+            }
+        }
+    }
+
+    template<typename T>
+    std::pair<Vector3<T>, Rotator3<T>> Matrix3x3<T>::EigenSymmetric(std::size_t sweeps) const noexcept
+    {
+        T a[6][1] = { { line0.x }, { line0.y }, { line0.z }, { line1.y }, { line1.z }, { line2.z } };
+        T q[4][1];
+        EigenSymmetricLanes(a, q, sweeps);
+        return
+        {
+            Vector3<T>{ a[0][0], a[3][0], a[5][0] },
+            Rotator3<T>(Quaternion<T>{ q[0][0], { q[1][0], q[2][0], q[3][0] } })
+        };
+    }
+
+    template<typename T>
+    void Matrix3x3<T>::EigenSymmetric(Symmetric3SoA<const T> matrices, Vector3SoA<T> values, QuaternionSoA<T> bases, std::size_t sweeps) noexcept
+    {
+        constexpr std::size_t lanes = 8;
+        for(std::size_t begin = 0; begin < matrices.size; begin += lanes)
+        {
+            const std::size_t count = std::min(lanes, matrices.size - begin);
+            // the tail of the last block repeats its first matrix
+            T a[6][lanes];
+            T q[4][lanes];
+            for(std::size_t l = 0; l < lanes; ++l)
+            {
+                const std::size_t i = begin + (l < count ? l : 0);
+                a[0][l] = matrices.xx[i];
+                a[1][l] = matrices.xy[i];
+                a[2][l] = matrices.xz[i];
+                a[3][l] = matrices.yy[i];
+                a[4][l] = matrices.yz[i];
+                a[5][l] = matrices.zz[i];
+            }
+            EigenSymmetricLanes(a, q, sweeps);
+            for(std::size_t l = 0; l < count; ++l)
+            {
+                const std::size_t i = begin + l;
+                values.x[i] = a[0][l];
+                values.y[i] = a[3][l];
+                values.z[i] = a[5][l];
+                bases.re[i] = q[0][l];
+                bases.x[i] = q[1][l];
+                bases.y[i] = q[2][l];
+                bases.z[i] = q[3][l];
+            }
+        }
+    }
+
+    template<typename T>
+    void Matrix3x3<T>::EigenSymmetric(const Execution& execution, Symmetric3SoA<const T> matrices, Vector3SoA<T> values, QuaternionSoA<T> bases, std::size_t sweeps)
+    {
+        Parallel::For(matrices.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            EigenSymmetric(matrices.Slice(begin, end - begin), values.Slice(begin, end - begin), bases.Slice(begin, end - begin), sweeps);
+        }, execution);
+    }
+} // namespace linal
@@ -0,0 +1,673 @@
+#pragma once
+#include "Linal.h"
+#include <cmath>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace linal
+{
+
+    template<typename FunctionT, std::size_t... indices>
+    void Unroll(FunctionT&& function, std::index_sequence<indices...>)
+    {
+        (function(std::integral_constant<std::size_t, indices>()), ...);
+    }
+
+    template<std::size_t count, typename FunctionT>
+    void Unroll(FunctionT&& function)
+    {
+        Unroll(function, std::make_index_sequence<count>());
+    }
+
+//==============================================================================================================================================
+
+    template<typename T, std::size_t size>
+    T& Vector<T, size>::operator[](std::size_t index) noexcept
+    {
+        return values[index];
+    }
+
+    template<typename T, std::size_t size>
+    const T& Vector<T, size>::operator[](std::size_t index) const noexcept
+    {
+        return values[index];
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size>& Vector<T, size>::operator+=(const Vector<T, size>& other) noexcept
+    {
+        Unroll<size>([&](auto i) { values[i] += other.values[i]; });
+        return *this;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size>& Vector<T, size>::operator-=(const Vector<T, size>& other) noexcept
+    {
+        Unroll<size>([&](auto i) { values[i] -= other.values[i]; });
+        return *this;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size>& Vector<T, size>::operator*=(const T& scalar) noexcept
+    {
+        Unroll<size>([&](auto i) { values[i] *= scalar; });
+        return *this;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size>& Vector<T, size>::operator/=(const T& scalar)
+    {
+        Unroll<size>([&](auto i) { values[i] /= scalar; });
+        return *this;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::operator+(const Vector<T, size>& other) const noexcept
+    {
+        return Vector<T, size>(*this) += other;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::operator-(const Vector<T, size>& other) const noexcept
+    {
+        return Vector<T, size>(*this) -= other;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::operator*(const T& scalar) const noexcept
+    {
+        return Vector<T, size>(*this) *= scalar;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::operator/(const T& scalar) const
+    {
+        return Vector<T, size>(*this) /= scalar;
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::operator-() const noexcept
+    {
+        Vector<T, size> result;
+        Unroll<size>([&](auto i) { result.values[i] = -values[i]; });
+        return result;
+    }
+
+    template<typename T, std::size_t size>
+    template<std::size_t columns>
+    Vector<T, columns> Vector<T, size>::operator*(const Matrix<T, size, columns>& matrix) const noexcept
+    {
+        // sum of the lines scaled by the elements
+        Vector<T, columns> result = matrix.lines[0] * values[0];
+        Unroll<size - 1>([&](auto i) { result += matrix.lines[i + 1] * values[i + 1]; });
+        return result;
+    }
+
+    template<typename T, std::size_t size>
+    T Vector<T, size>::Dot(const Vector<T, size>& other) const noexcept
+    {
+        T result = values[0] * other.values[0];
+        Unroll<size - 1>([&](auto i) { result += values[i + 1] * other.values[i + 1]; });
+        return result;
+    }
+
+    template<typename T, std::size_t size>
+    T Vector<T, size>::Abs2() const noexcept
+    {
+        return Dot(*this);
+    }
+
+    template<typename T, std::size_t size>
+    T Vector<T, size>::Abs() const noexcept
+    {
+        return std::sqrt(Abs2());
+    }
+
+    // sqrt_calculator should have method "Sqrt(const T&) -> T&&"
+    template<typename T, std::size_t size>
+    template<typename MathT>
+    T Vector<T, size>::Abs(MathT&& sqrt_calculator) const noexcept
+    {
+        return sqrt_calculator.Sqrt(Abs2());
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size>& Vector<T, size>::Normalize()
+    {
+        return *this /= Abs();
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::Normalized() const
+    {
+        return Vector<T, size>(*this).Normalize();
+    }
+
+    template<typename T, std::size_t size>
+    bool Vector<T, size>::operator==(const Vector<T, size>& other) const noexcept
+    {
+        return values == other.values;
+    }
+
+    template<typename T, std::size_t size>
+    bool Vector<T, size>::operator!=(const Vector<T, size>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    template<typename T, std::size_t size>
+    bool Vector<T, size>::Compare(const Vector<T, size>& other, const T& epsilon2) const noexcept
+    {
+        return (*this - other).Abs2() < epsilon2;
+    }
+
+    template<typename T, std::size_t size>
+    Vector2<T>& Vector<T, size>::AsVector2() noexcept
+    {
+        static_assert(sizeof(Vector<T, size>) == sizeof(Vector2<T>), "vector should have 2 elements");
+        return reinterpret_cast<Vector2<T>&>(*this);
+    }
+
+    template<typename T, std::size_t size>
+    const Vector2<T>& Vector<T, size>::AsVector2() const noexcept
+    {
+        static_assert(sizeof(Vector<T, size>) == sizeof(Vector2<T>), "vector should have 2 elements");
+        return reinterpret_cast<const Vector2<T>&>(*this);
+    }
+
+    template<typename T, std::size_t size>
+    Vector3<T>& Vector<T, size>::AsVector3() noexcept
+    {
+        static_assert(sizeof(Vector<T, size>) == sizeof(Vector3<T>), "vector should have 3 elements");
+        return reinterpret_cast<Vector3<T>&>(*this);
+    }
+
+    template<typename T, std::size_t size>
+    const Vector3<T>& Vector<T, size>::AsVector3() const noexcept
+    {
+        static_assert(sizeof(Vector<T, size>) == sizeof(Vector3<T>), "vector should have 3 elements");
+        return reinterpret_cast<const Vector3<T>&>(*this);
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::From(const Vector2<T>& vector) noexcept
+    {
+        static_assert(size == 2, "vector should have 2 elements");
+        return Vector<T, size>{{vector.x, vector.y}};
+    }
+
+    template<typename T, std::size_t size>
+    Vector<T, size> Vector<T, size>::From(const Vector3<T>& vector) noexcept
+    {
+        static_assert(size == 3, "vector should have 3 elements");
+        return Vector<T, size>{{vector.x, vector.y, vector.z}};
+    }
+
+    template<typename T, std::size_t size>
+    const Vector<T, size> Vector<T, size>::zero = {};
+
+    template<typename T, std::size_t size>
+    const Vector<T, size> Vector<T, size>::ones = []()
+    {
+        Vector<T, size> result;
+        result.values.fill(T(1));
+        return result;
+    }();
+
+//==============================================================================================================================================
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Vector<T, columns>& Matrix<T, rows, columns>::operator[](std::size_t row) noexcept
+    {
+        return lines[row];
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    const Vector<T, columns>& Matrix<T, rows, columns>::operator[](std::size_t row) const noexcept
+    {
+        return lines[row];
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns>& Matrix<T, rows, columns>::operator+=(const Matrix<T, rows, columns>& other) noexcept
+    {
+        Unroll<rows>([&](auto i) { lines[i] += other.lines[i]; });
+        return *this;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns>& Matrix<T, rows, columns>::operator-=(const Matrix<T, rows, columns>& other) noexcept
+    {
+        Unroll<rows>([&](auto i) { lines[i] -= other.lines[i]; });
+        return *this;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns>& Matrix<T, rows, columns>::operator*=(const T& scalar) noexcept
+    {
+        Unroll<rows>([&](auto i) { lines[i] *= scalar; });
+        return *this;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns>& Matrix<T, rows, columns>::operator/=(const T& scalar)
+    {
+        Unroll<rows>([&](auto i) { lines[i] /= scalar; });
+        return *this;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::operator+(const Matrix<T, rows, columns>& other) const noexcept
+    {
+        return Matrix<T, rows, columns>(*this) += other;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::operator-(const Matrix<T, rows, columns>& other) const noexcept
+    {
+        return Matrix<T, rows, columns>(*this) -= other;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::operator*(const T& scalar) const noexcept
+    {
+        return Matrix<T, rows, columns>(*this) *= scalar;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::operator/(const T& scalar) const
+    {
+        return Matrix<T, rows, columns>(*this) /= scalar;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::operator-() const noexcept
+    {
+        Matrix<T, rows, columns> result;
+        Unroll<rows>([&](auto i) { result.lines[i] = -lines[i]; });
+        return result;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    template<std::size_t other_columns>
+    Matrix<T, rows, other_columns> Matrix<T, rows, columns>::operator*(const Matrix<T, columns, other_columns>& other) const noexcept
+    {
+        // every line of the result is the line of *this times other
+        Matrix<T, rows, other_columns> result;
+        Unroll<rows>([&](auto i) { result.lines[i] = lines[i] * other; });
+        return result;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Vector<T, rows> Matrix<T, rows, columns>::operator*(const Vector<T, columns>& vector) const noexcept
+    {
+        Vector<T, rows> result;
+        Unroll<rows>([&](auto i) { result.values[i] = lines[i].Dot(vector); });
+        return result;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    bool Matrix<T, rows, columns>::operator==(const Matrix<T, rows, columns>& other) const noexcept
+    {
+        return lines == other.lines;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    bool Matrix<T, rows, columns>::operator!=(const Matrix<T, rows, columns>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    bool Matrix<T, rows, columns>::Compare(const Matrix<T, rows, columns>& other, const T& epsilon2) const noexcept
+    {
+        T sum = 0;
+        Unroll<rows>([&](auto i) { sum += (lines[i] - other.lines[i]).Abs2(); });
+        return sum < epsilon2;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, columns, rows> Matrix<T, rows, columns>::Transposed() const noexcept
+    {
+        Matrix<T, columns, rows> result;
+        Unroll<rows>([&](auto i)
+        {
+            Unroll<columns>([&](auto j) { result.lines[j].values[i] = lines[i].values[j]; });
+        });
+        return result;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    bool Matrix<T, rows, columns>::Decompose(Matrix<T, rows, columns>& lu, std::array<std::size_t, rows>& permutation, T& sign) noexcept
+    {
+        sign = T(1);
+        for(std::size_t i = 0; i < rows; ++i)
+        {
+            permutation[i] = i;
+        }
+        for(std::size_t k = 0; k < rows; ++k)
+        {
+            std::size_t pivot = k;
+            for(std::size_t i = k + 1; i < rows; ++i)
+            {
+                if(std::abs(lu.lines[i].values[k]) > std::abs(lu.lines[pivot].values[k]))
+                {
+                    pivot = i;
+                }
+            }
+            if(lu.lines[pivot].values[k] == 0)
+            {
+                return false;
+            }
+            if(pivot != k)
+            {
+                std::swap(lu.lines[pivot], lu.lines[k]);
+                std::swap(permutation[pivot], permutation[k]);
+                sign = -sign;
+            }
+            // multipliers are stored in place of the eliminated elements, the unit diagonal of l is implied
+            const T inv = T(1) / lu.lines[k].values[k];
+            for(std::size_t i = k + 1; i < rows; ++i)
+            {
+                const T factor = lu.lines[i].values[k] * inv;
+                lu.lines[i].values[k] = factor;
+                for(std::size_t j = k + 1; j < columns; ++j)
+                {
+                    lu.lines[i].values[j] -= factor * lu.lines[k].values[j];
+                }
+            }
+        }
+        return true;
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    T Matrix<T, rows, columns>::Det() const noexcept
+    {
+        static_assert(rows == columns, "determinant needs a square matrix");
+        const auto& m = lines;
+        if constexpr(rows == 1)
+        {
+            return m[0][0];
+        }
+        else if constexpr(rows == 2)
+        {
+            return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        }
+        else if constexpr(rows == 3)
+        {
+            return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                + m[0][1] * (m[1][2] * m[2][0] - m[1][0] * m[2][2])
+                + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+        }
+        else if constexpr(rows == 4)
+        {
+            // 2x2 minors of the upper and the lower pair of lines
+            const T s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+            const T s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+            const T s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+            const T s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+            const T s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+            const T s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+            const T c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+            const T c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+            const T c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+            const T c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+            const T c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+            const T c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+        else
+        {
+            Matrix<T, rows, columns> lu = *this;
+            std::array<std::size_t, rows> permutation;
+            T result;
+            if(!Decompose(lu, permutation, result))
+            {
+                return T(0);
+            }
+            for(std::size_t i = 0; i < rows; ++i)
+            {
+                result *= lu.lines[i].values[i];
+            }
+            return result;
+        }
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::Inversed() const
+    {
+        static_assert(rows == columns, "inverse needs a square matrix");
+        const auto& m = lines;
+        Matrix<T, rows, columns> result;
+        auto& r = result.lines;
+        if constexpr(rows <= 3)
+        {
+            const T det = Det();
+            if(det == 0)
+            {
+                throw std::runtime_error("can't invert matrix with det == 0");
+            }
+            if constexpr(rows == 1)
+            {
+                r[0][0] = T(1);
+            }
+            else if constexpr(rows == 2)
+            {
+                r[0] = {{m[1][1], -m[0][1]}};
+                r[1] = {{-m[1][0], m[0][0]}};
+            }
+            else
+            {
+                // columns of the inverse are cross products of the lines
+                r[0] = {{m[1][1] * m[2][2] - m[1][2] * m[2][1], m[2][1] * m[0][2] - m[2][2] * m[0][1], m[0][1] * m[1][2] - m[0][2] * m[1][1]}};
+                r[1] = {{m[1][2] * m[2][0] - m[1][0] * m[2][2], m[2][2] * m[0][0] - m[2][0] * m[0][2], m[0][2] * m[1][0] - m[0][0] * m[1][2]}};
+                r[2] = {{m[1][0] * m[2][1] - m[1][1] * m[2][0], m[2][0] * m[0][1] - m[2][1] * m[0][0], m[0][0] * m[1][1] - m[0][1] * m[1][0]}};
+            }
+            return result /= det;
+        }
+        else if constexpr(rows == 4)
+        {
+            // adjugate from the same 2x2 minors as Det()
+            const T s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+            const T s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+            const T s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+            const T s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+            const T s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+            const T s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+            const T c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+            const T c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+            const T c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+            const T c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+            const T c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+            const T c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+            const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            if(det == 0)
+            {
+                throw std::runtime_error("can't invert matrix with det == 0");
+            }
+            r[0] = {{ m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3, -m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3,
+                      m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3, -m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3}};
+            r[1] = {{-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1,  m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1,
+                     -m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1,  m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1}};
+            r[2] = {{ m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0, -m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0,
+                      m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0, -m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0}};
+            r[3] = {{-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0,  m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0,
+                     -m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0,  m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0}};
+            return result *= T(1) / det;
+        }
+        else
+        {
+            Matrix<T, rows, columns> lu = *this;
+            std::array<std::size_t, rows> permutation;
+            T sign;
+            if(!Decompose(lu, permutation, sign))
+            {
+                throw std::runtime_error("can't invert singular matrix");
+            }
+            // solves lu * x = e_c for every column c of the identity
+            for(std::size_t c = 0; c < columns; ++c)
+            {
+                Vector<T, rows> x;
+                for(std::size_t i = 0; i < rows; ++i)
+                {
+                    T sum = permutation[i] == c ? T(1) : T(0);
+                    for(std::size_t j = 0; j < i; ++j)
+                    {
+                        sum -= lu.lines[i].values[j] * x.values[j];
+                    }
+                    x.values[i] = sum;
+                }
+                for(std::size_t i = rows; i-- > 0;)
+                {
+                    T sum = x.values[i];
+                    for(std::size_t j = i + 1; j < rows; ++j)
+                    {
+                        sum -= lu.lines[i].values[j] * x.values[j];
+                    }
+                    x.values[i] = sum / lu.lines[i].values[i];
+                }
+                for(std::size_t i = 0; i < rows; ++i)
+                {
+                    r[i].values[c] = x.values[i];
+                }
+            }
+            return result;
+        }
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix2x2<T>& Matrix<T, rows, columns>::AsMatrix2x2() noexcept
+    {
+        static_assert(rows == 2 && columns == 2, "matrix should be 2x2");
+        static_assert(sizeof(Matrix<T, rows, columns>) == sizeof(Matrix2x2<T>), "matrix structs should be simillar");
+        return reinterpret_cast<Matrix2x2<T>&>(*this);
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    const Matrix2x2<T>& Matrix<T, rows, columns>::AsMatrix2x2() const noexcept
+    {
+        static_assert(rows == 2 && columns == 2, "matrix should be 2x2");
+        static_assert(sizeof(Matrix<T, rows, columns>) == sizeof(Matrix2x2<T>), "matrix structs should be simillar");
+        return reinterpret_cast<const Matrix2x2<T>&>(*this);
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix3x3<T>& Matrix<T, rows, columns>::AsMatrix3x3() noexcept
+    {
+        static_assert(rows == 3 && columns == 3, "matrix should be 3x3");
+        static_assert(sizeof(Matrix<T, rows, columns>) == sizeof(Matrix3x3<T>), "matrix structs should be simillar");
+        return reinterpret_cast<Matrix3x3<T>&>(*this);
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    const Matrix3x3<T>& Matrix<T, rows, columns>::AsMatrix3x3() const noexcept
+    {
+        static_assert(rows == 3 && columns == 3, "matrix should be 3x3");
+        static_assert(sizeof(Matrix<T, rows, columns>) == sizeof(Matrix3x3<T>), "matrix structs should be simillar");
+        return reinterpret_cast<const Matrix3x3<T>&>(*this);
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::From(const Matrix2x2<T>& matrix) noexcept
+    {
+        static_assert(rows == 2 && columns == 2, "matrix should be 2x2");
+        return Matrix<T, rows, columns>{{Vector<T, 2>::From(matrix.line0), Vector<T, 2>::From(matrix.line1)}};
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    Matrix<T, rows, columns> Matrix<T, rows, columns>::From(const Matrix3x3<T>& matrix) noexcept
+    {
+        static_assert(rows == 3 && columns == 3, "matrix should be 3x3");
+        return Matrix<T, rows, columns>{{Vector<T, 3>::From(matrix.line0), Vector<T, 3>::From(matrix.line1), Vector<T, 3>::From(matrix.line2)}};
+    }
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    const Matrix<T, rows, columns> Matrix<T, rows, columns>::one = []()
+    {
+        Matrix<T, rows, columns> result;
+        for(std::size_t i = 0; i < rows && i < columns; ++i)
+        {
+            result.lines[i].values[i] = T(1);
+        }
+        return result;
+    }();
+
+    template<typename T, std::size_t rows, std::size_t columns>
+    const Matrix<T, rows, columns> Matrix<T, rows, columns>::zero = {};
+
+//==============================================================================================================================================
+
+#if defined(__SSE__)
+
+    template<>
+    template<>
+    inline Vector<float, 4> Vector<float, 4>::operator*<4>(const Matrix<float, 4, 4>& matrix) const noexcept
+    {
+        __m128 line = _mm_mul_ps(_mm_set1_ps(values[0]), _mm_loadu_ps(matrix.lines[0].values.data()));
+        line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(values[1]), _mm_loadu_ps(matrix.lines[1].values.data())));
+        line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(values[2]), _mm_loadu_ps(matrix.lines[2].values.data())));
+        line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(values[3]), _mm_loadu_ps(matrix.lines[3].values.data())));
+        Vector<float, 4> result;
+        _mm_storeu_ps(result.values.data(), line);
+        return result;
+    }
+
+    template<>
+    template<>
+    inline Matrix<float, 4, 4> Matrix<float, 4, 4>::operator*<4>(const Matrix<float, 4, 4>& other) const noexcept
+    {
+        const __m128 b0 = _mm_loadu_ps(other.lines[0].values.data());
+        const __m128 b1 = _mm_loadu_ps(other.lines[1].values.data());
+        const __m128 b2 = _mm_loadu_ps(other.lines[2].values.data());
+        const __m128 b3 = _mm_loadu_ps(other.lines[3].values.data());
+        Matrix<float, 4, 4> result;
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            const Vector<float, 4>& a = lines[i];
+            __m128 line = _mm_mul_ps(_mm_set1_ps(a.values[0]), b0);
+            line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(a.values[1]), b1));
+            line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(a.values[2]), b2));
+            line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(a.values[3]), b3));
+            _mm_storeu_ps(result.lines[i].values.data(), line);
+        }
+        return result;
+    }
+
+    template<>
+    inline Vector<float, 4> Matrix<float, 4, 4>::operator*(const Vector<float, 4>& vector) const noexcept
+    {
+        // columns of *this scaled by the elements of the vector
+        __m128 c0 = _mm_loadu_ps(lines[0].values.data());
+        __m128 c1 = _mm_loadu_ps(lines[1].values.data());
+        __m128 c2 = _mm_loadu_ps(lines[2].values.data());
+        __m128 c3 = _mm_loadu_ps(lines[3].values.data());
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m128 line = _mm_mul_ps(_mm_set1_ps(vector.values[0]), c0);
+        line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(vector.values[1]), c1));
+        line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(vector.values[2]), c2));
+        line = _mm_add_ps(line, _mm_mul_ps(_mm_set1_ps(vector.values[3]), c3));
+        Vector<float, 4> result;
+        _mm_storeu_ps(result.values.data(), line);
+        return result;
+    }
+
+    template<>
+    inline Matrix<float, 4, 4> Matrix<float, 4, 4>::Transposed() const noexcept
+    {
+        __m128 l0 = _mm_loadu_ps(lines[0].values.data());
+        __m128 l1 = _mm_loadu_ps(lines[1].values.data());
+        __m128 l2 = _mm_loadu_ps(lines[2].values.data());
+        __m128 l3 = _mm_loadu_ps(lines[3].values.data());
+        _MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+        Matrix<float, 4, 4> result;
+        _mm_storeu_ps(result.lines[0].values.data(), l0);
+        _mm_storeu_ps(result.lines[1].values.data(), l1);
+        _mm_storeu_ps(result.lines[2].values.data(), l2);
+        _mm_storeu_ps(result.lines[3].values.data(), l3);
+        return result;
+    }
+
+#endif
+
+} // namespace linal
@@ -0,0 +1,371 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cmath>
+
+namespace linal
+{
+
+    template<typename T>
+    MeshAttributes<T>::VertexFaces::VertexFaces(const std::uint32_t* indices, std::size_t triangle_count, std::size_t vertex_count)
+        : offsets(vertex_count + 1, 0), faces(triangle_count * 3)
+    {
+        // counting sort of the corners by vertex, faces stay ascending inside a vertex
+        for(std::size_t i = 0; i < triangle_count * 3; ++i)
+        {
+            if(indices[i] >= vertex_count)
+            {
+                throw std::runtime_error("vertex index out of range");
+            }
+            ++offsets[indices[i] + 1];
+        }
+        for(std::size_t vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+        std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+        for(std::size_t i = 0; i < triangle_count * 3; ++i)
+        {
+            faces[next[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+    }
+
+    template<typename T>
+    std::size_t MeshAttributes<T>::VertexFaces::VertexCount() const noexcept
+    {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    template<typename T>
+    std::size_t MeshAttributes<T>::VertexFaces::TriangleCount() const noexcept
+    {
+        return faces.size() / 3;
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    void MeshAttributes<T>::NormalizeLane(T& x, T& y, T& z) noexcept
+    {
+        const T length2 = x * x + y * y + z * z;
+        const T inv = length2 > 0 ? T(1) / std::sqrt(length2 > 0 ? length2 : T(1)) : T(0);
+        x *= inv;
+        y *= inv;
+        z *= inv;
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::FaceNormalLane(const Vector3SoA<const T>& positions, std::uint32_t a, std::uint32_t b, std::uint32_t c,
+        T& x, T& y, T& z) noexcept
+    {
+        const T e1x = positions.x[b] - positions.x[a];
+        const T e1y = positions.y[b] - positions.y[a];
+        const T e1z = positions.z[b] - positions.z[a];
+        const T e2x = positions.x[c] - positions.x[a];
+        const T e2y = positions.y[c] - positions.y[a];
+        const T e2z = positions.z[c] - positions.z[a];
+        x = e1y * e2z - e1z * e2y;
+        y = e1z * e2x - e1x * e2z;
+        z = e1x * e2y - e1y * e2x;
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::FaceNormals(Vector3SoA<const T> positions, const std::uint32_t* indices, Vector3SoA<T> face_normals) noexcept
+    {
+        for(std::size_t t = 0; t < face_normals.size; ++t)
+        {
+            FaceNormalLane(positions, indices[3 * t], indices[3 * t + 1], indices[3 * t + 2], face_normals.x[t], face_normals.y[t], face_normals.z[t]);
+        }
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::FaceNormals(const Execution& execution, Vector3SoA<const T> positions, const std::uint32_t* indices, Vector3SoA<T> face_normals)
+    {
+        Parallel::For(face_normals.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            FaceNormals(positions, indices + 3 * begin, face_normals.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::VertexNormals(Vector3SoA<const T> positions, const std::uint32_t* indices, std::size_t triangle_count,
+        Vector3SoA<T> normals) noexcept
+    {
+        for(std::size_t vertex = 0; vertex < normals.size; ++vertex)
+        {
+            normals.x[vertex] = T(0);
+            normals.y[vertex] = T(0);
+            normals.z[vertex] = T(0);
+        }
+        // the cross product is twice the area along the normal, so the plain sum is area weighted
+        for(std::size_t t = 0; t < triangle_count; ++t)
+        {
+            T x, y, z;
+            FaceNormalLane(positions, indices[3 * t], indices[3 * t + 1], indices[3 * t + 2], x, y, z);
+            for(std::size_t corner = 0; corner < 3; ++corner)
+            {
+                const std::uint32_t vertex = indices[3 * t + corner];
+                normals.x[vertex] += x;
+                normals.y[vertex] += y;
+                normals.z[vertex] += z;
+            }
+        }
+        for(std::size_t vertex = 0; vertex < normals.size; ++vertex)
+        {
+            NormalizeLane(normals.x[vertex], normals.y[vertex], normals.z[vertex]);
+        }
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::VertexNormals(const Execution& execution, Vector3SoA<const T> positions, const std::uint32_t* indices,
+        const VertexFaces& vertex_faces, Vector3SoA<T> normals)
+    {
+        Vector3Buffer<T> face_normals(vertex_faces.TriangleCount());
+        FaceNormals(execution, positions, indices, face_normals.AsVector3());
+
+        const Vector3SoA<const T> faces = face_normals.AsVector3();
+        Parallel::For(normals.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t vertex = begin; vertex < end; ++vertex)
+            {
+                T x = T(0);
+                T y = T(0);
+                T z = T(0);
+                for(std::uint32_t i = vertex_faces.offsets[vertex]; i < vertex_faces.offsets[vertex + 1]; ++i)
+                {
+                    const std::uint32_t face = vertex_faces.faces[i];
+                    x += faces.x[face];
+                    y += faces.y[face];
+                    z += faces.z[face];
+                }
+                NormalizeLane(x, y, z);
+                normals.x[vertex] = x;
+                normals.y[vertex] = y;
+                normals.z[vertex] = z;
+            }
+        }, execution);
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    void MeshAttributes<T>::FaceTangentLane(
+        const T& ax, const T& ay, const T& az, const T& bx, const T& by, const T& bz, const T& cx, const T& cy, const T& cz,
+        const T& au, const T& av, const T& bu, const T& bv, const T& cu, const T& cv,
+        T& tx, T& ty, T& tz, T& sx, T& sy, T& sz) noexcept
+    {
+        // e1 = du1 * t + dv1 * s, e2 = du2 * t + dv2 * s solved for t and s
+        const T e1x = bx - ax;
+        const T e1y = by - ay;
+        const T e1z = bz - az;
+        const T e2x = cx - ax;
+        const T e2y = cy - ay;
+        const T e2z = cz - az;
+        const T du1 = bu - au;
+        const T dv1 = bv - av;
+        const T du2 = cu - au;
+        const T dv2 = cv - av;
+        const T det = du1 * dv2 - du2 * dv1;
+        const bool valid = det != 0;
+        const T inv = valid ? T(1) / (valid ? det : T(1)) : T(0);
+        tx = (e1x * dv2 - e2x * dv1) * inv;
+        ty = (e1y * dv2 - e2y * dv1) * inv;
+        tz = (e1z * dv2 - e2z * dv1) * inv;
+        sx = (e2x * du1 - e1x * du2) * inv;
+        sy = (e2y * du1 - e1y * du2) * inv;
+        sz = (e2z * du1 - e1z * du2) * inv;
+    }
+
+    template<typename T>
+    T MeshAttributes<T>::OrientationLane(const T& nx, const T& ny, const T& nz, const T& tx, const T& ty, const T& tz,
+        const T& sx, const T& sy, const T& sz) noexcept
+    {
+        return (ny * tz - nz * ty) * sx + (nz * tx - nx * tz) * sy + (nx * ty - ny * tx) * sz;
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::FrameLane(const T& nx, const T& ny, const T& nz, T& tx, T& ty, T& tz, T& handedness) noexcept
+    {
+        // gram schmidt against the normal
+        const T along = nx * tx + ny * ty + nz * tz;
+        T x = tx - nx * along;
+        T y = ty - ny * along;
+        T z = tz - nz * along;
+
+        // without a tangent any direction orthogonal to the normal is used
+        const bool valid = x * x + y * y + z * z > 0;
+        const bool x_major = std::abs(nx) > std::abs(nz);
+        x = valid ? x : (x_major ? -ny : T(0));
+        y = valid ? y : (x_major ? nx : -nz);
+        z = valid ? z : (x_major ? T(0) : ny);
+        NormalizeLane(x, y, z);
+        // the tangent of a vertex without a normal is zero like the normal
+        const bool has_normal = nx * nx + ny * ny + nz * nz > 0;
+        tx = has_normal ? x : T(0);
+        ty = has_normal ? y : T(0);
+        tz = has_normal ? z : T(0);
+        handedness = handedness < 0 ? T(-1) : T(1);
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::Tangents(Vector3SoA<const T> positions, Vector2SoA<const T> uvs, const std::uint32_t* indices, std::size_t triangle_count,
+        Vector3SoA<const T> normals, Vector3SoA<T> tangents, T* handedness) noexcept
+    {
+        for(std::size_t vertex = 0; vertex < tangents.size; ++vertex)
+        {
+            tangents.x[vertex] = T(0);
+            tangents.y[vertex] = T(0);
+            tangents.z[vertex] = T(0);
+            handedness[vertex] = T(0);
+        }
+        for(std::size_t t = 0; t < triangle_count; ++t)
+        {
+            const std::uint32_t a = indices[3 * t];
+            const std::uint32_t b = indices[3 * t + 1];
+            const std::uint32_t c = indices[3 * t + 2];
+            T tx, ty, tz, sx, sy, sz;
+            FaceTangentLane(
+                positions.x[a], positions.y[a], positions.z[a], positions.x[b], positions.y[b], positions.z[b],
+                positions.x[c], positions.y[c], positions.z[c],
+                uvs.x[a], uvs.y[a], uvs.x[b], uvs.y[b], uvs.x[c], uvs.y[c],
+                tx, ty, tz, sx, sy, sz);
+            for(std::size_t corner = 0; corner < 3; ++corner)
+            {
+                const std::uint32_t vertex = indices[3 * t + corner];
+                tangents.x[vertex] += tx;
+                tangents.y[vertex] += ty;
+                tangents.z[vertex] += tz;
+                handedness[vertex] += OrientationLane(normals.x[vertex], normals.y[vertex], normals.z[vertex], tx, ty, tz, sx, sy, sz);
+            }
+        }
+        for(std::size_t vertex = 0; vertex < tangents.size; ++vertex)
+        {
+            FrameLane(normals.x[vertex], normals.y[vertex], normals.z[vertex],
+                tangents.x[vertex], tangents.y[vertex], tangents.z[vertex], handedness[vertex]);
+        }
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::Tangents(const Execution& execution, Vector3SoA<const T> positions, Vector2SoA<const T> uvs, const std::uint32_t* indices,
+        const VertexFaces& vertex_faces, Vector3SoA<const T> normals, Vector3SoA<T> tangents, T* handedness)
+    {
+        // {tangent, bitangent} of every face
+        SoABuffer<T, 6> frames(vertex_faces.TriangleCount());
+        T* f[6];
+        for(std::size_t c = 0; c < 6; ++c)
+        {
+            f[c] = frames.Component(c);
+        }
+        Parallel::For(vertex_faces.TriangleCount(), Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t t = begin; t < end; ++t)
+            {
+                const std::uint32_t a = indices[3 * t];
+                const std::uint32_t b = indices[3 * t + 1];
+                const std::uint32_t c = indices[3 * t + 2];
+                FaceTangentLane(
+                    positions.x[a], positions.y[a], positions.z[a], positions.x[b], positions.y[b], positions.z[b],
+                    positions.x[c], positions.y[c], positions.z[c],
+                    uvs.x[a], uvs.y[a], uvs.x[b], uvs.y[b], uvs.x[c], uvs.y[c],
+                    f[0][t], f[1][t], f[2][t], f[3][t], f[4][t], f[5][t]);
+            }
+        }, execution);
+
+        Parallel::For(tangents.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t vertex = begin; vertex < end; ++vertex)
+            {
+                const T nx = normals.x[vertex];
+                const T ny = normals.y[vertex];
+                const T nz = normals.z[vertex];
+                T x = T(0);
+                T y = T(0);
+                T z = T(0);
+                T vote = T(0);
+                for(std::uint32_t i = vertex_faces.offsets[vertex]; i < vertex_faces.offsets[vertex + 1]; ++i)
+                {
+                    const std::uint32_t face = vertex_faces.faces[i];
+                    x += f[0][face];
+                    y += f[1][face];
+                    z += f[2][face];
+                    vote += OrientationLane(nx, ny, nz, f[0][face], f[1][face], f[2][face], f[3][face], f[4][face], f[5][face]);
+                }
+                FrameLane(nx, ny, nz, x, y, z, vote);
+                tangents.x[vertex] = x;
+                tangents.y[vertex] = y;
+                tangents.z[vertex] = z;
+                handedness[vertex] = vote;
+            }
+        }, execution);
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    void MeshAttributes<T>::EncodeLane(const T& x, const T& y, const T& z, std::int16_t& u, std::int16_t& v) noexcept
+    {
+        // project on the octahedron |x| + |y| + |z| = 1 and fold the lower half over the diagonals
+        const T sum = std::abs(x) + std::abs(y) + std::abs(z);
+        const T inv = sum > 0 ? T(1) / (sum > 0 ? sum : T(1)) : T(0);
+        const T px = x * inv;
+        const T py = y * inv;
+        const T folded_x = (T(1) - std::abs(py)) * (px < 0 ? T(-1) : T(1));
+        const T folded_y = (T(1) - std::abs(px)) * (py < 0 ? T(-1) : T(1));
+        const T ox = z < 0 ? folded_x : px;
+        const T oy = z < 0 ? folded_y : py;
+        // round half away from zero
+        u = static_cast<std::int16_t>(ox * T(32767) + (ox < 0 ? T(-0.5) : T(0.5)));
+        v = static_cast<std::int16_t>(oy * T(32767) + (oy < 0 ? T(-0.5) : T(0.5)));
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::DecodeLane(const std::int16_t& u, const std::int16_t& v, T& x, T& y, T& z) noexcept
+    {
+        // -32768 is clamped like any snorm
+        const T ox = std::max(T(u) / T(32767), T(-1));
+        const T oy = std::max(T(v) / T(32767), T(-1));
+        const T oz = T(1) - std::abs(ox) - std::abs(oy);
+        const T fold = oz < 0 ? -oz : T(0);
+        x = ox + (ox < 0 ? fold : -fold);
+        y = oy + (oy < 0 ? fold : -fold);
+        z = oz;
+        NormalizeLane(x, y, z);
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::EncodeOctahedral(Vector3SoA<const T> directions, std::int16_t* u, std::int16_t* v) noexcept
+    {
+        for(std::size_t i = 0; i < directions.size; ++i)
+        {
+            EncodeLane(directions.x[i], directions.y[i], directions.z[i], u[i], v[i]);
+        }
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::DecodeOctahedral(const std::int16_t* u, const std::int16_t* v, Vector3SoA<T> directions) noexcept
+    {
+        for(std::size_t i = 0; i < directions.size; ++i)
+        {
+            DecodeLane(u[i], v[i], directions.x[i], directions.y[i], directions.z[i]);
+        }
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::EncodeOctahedral(const Execution& execution, Vector3SoA<const T> directions, std::int16_t* u, std::int16_t* v)
+    {
+        Parallel::For(directions.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            EncodeOctahedral(directions.Slice(begin, end - begin), u + begin, v + begin);
+        }, execution);
+    }
+
+    template<typename T>
+    void MeshAttributes<T>::DecodeOctahedral(const Execution& execution, const std::int16_t* u, const std::int16_t* v, Vector3SoA<T> directions)
+    {
+        Parallel::For(directions.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            DecodeOctahedral(u + begin, v + begin, directions.Slice(begin, end - begin));
+        }, execution);
+    }
+
+} // namespace linal
@@ -0,0 +1,103 @@
+#pragma once
+#include "Linal.h"
+#include <thread>
+#include <exception>
+#include <mutex>
+#include <algorithm>
+
+namespace linal
+{
+    inline Execution::Execution(unsigned thread_count) noexcept
+        : thread_count(thread_count)
+    {}
+
+    inline Execution::Execution(Kind kind, unsigned thread_count, Executor* executor) noexcept
+        : kind(kind), thread_count(thread_count), executor(executor)
+    {}
+
+    inline Execution Execution::On(Executor& executor, unsigned thread_count) noexcept
+    {
+        return Execution(Kind::parallel, thread_count, &executor);
+    }
+
+    inline unsigned Execution::ThreadCount() const noexcept
+    {
+        return kind == Kind::parallel ? Parallel::ThreadCount(thread_count) : 1;
+    }
+
+    inline const Execution Execution::sequenced = Execution(Execution::Kind::sequenced);
+    inline const Execution Execution::unsequenced = Execution(Execution::Kind::unsequenced);
+    inline const Execution Execution::parallel = Execution(Execution::Kind::parallel);
+
+    inline unsigned Parallel::ThreadCount(unsigned thread_count) noexcept
+    {
+        if(thread_count != 0)
+        {
+            return thread_count;
+        }
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware != 0 ? hardware : 1;
+    }
+
+    template<typename FunctionT>
+    void Parallel::For(std::size_t count, std::size_t grain, FunctionT&& function, const Execution& execution)
+    {
+        if(count == 0)
+        {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+        std::size_t blocks = (count + grain - 1) / grain;
+        std::size_t chunks = std::min<std::size_t>(execution.ThreadCount(), blocks);
+        if(chunks <= 1)
+        {
+            function(std::size_t{0}, count);
+            return;
+        }
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        // chunk c gets whole blocks of grain elements
+        auto run = [&](std::size_t c)
+        {
+            std::size_t begin = std::min(blocks * c / chunks * grain, count);
+            std::size_t end = std::min(blocks * (c + 1) / chunks * grain, count);
+            try
+            {
+                function(begin, end);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if(!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        };
+
+        if(execution.executor)
+        {
+            execution.executor->Run(chunks, run);
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(chunks - 1);
+            for(std::size_t c = 0; c + 1 < chunks; ++c)
+            {
+                threads.emplace_back(run, c);
+            }
+            run(chunks - 1);
+            for(std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+} // namespace linal
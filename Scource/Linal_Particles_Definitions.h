@@ -0,0 +1,349 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+#include <cmath>
+
+namespace linal
+{
+
+    template<typename T>
+    template<std::size_t dimensions>
+    void Particles<T>::SemiImplicitEuler(const std::array<T*, dimensions>& positions, const std::array<T*, dimensions>& velocities,
+        const std::array<const T*, dimensions>& accelerations, const std::array<T, dimensions>& gravity,
+        const T& damping, const T& dt, std::size_t count) noexcept
+    {
+        const T keep = std::max(T(0), T(1) - damping * dt);
+        // the components do not mix, every one is a separate simd loop
+        for(std::size_t c = 0; c < dimensions; ++c)
+        {
+            T* p = positions[c];
+            T* v = velocities[c];
+            const T* a = accelerations[c];
+            const T g = gravity[c];
+            if(a == nullptr)
+            {
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    v[i] = (v[i] + g * dt) * keep;
+                    p[i] += v[i] * dt;
+                }
+            }
+            else
+            {
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    v[i] = (v[i] + (g + a[i]) * dt) * keep;
+                    p[i] += v[i] * dt;
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    template<std::size_t dimensions>
+    void Particles<T>::Verlet(const std::array<T*, dimensions>& positions, const std::array<T*, dimensions>& previous_positions,
+        const std::array<const T*, dimensions>& accelerations, const std::array<T, dimensions>& gravity,
+        const T& damping, const T& dt, std::size_t count) noexcept
+    {
+        const T keep = std::max(T(0), T(1) - damping * dt);
+        const T dt2 = dt * dt;
+        for(std::size_t c = 0; c < dimensions; ++c)
+        {
+            T* p = positions[c];
+            T* previous = previous_positions[c];
+            const T* a = accelerations[c];
+            const T g = gravity[c];
+            if(a == nullptr)
+            {
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    const T current = p[i];
+                    p[i] = current + (current - previous[i]) * keep + g * dt2;
+                    previous[i] = current;
+                }
+            }
+            else
+            {
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    const T current = p[i];
+                    p[i] = current + (current - previous[i]) * keep + (g + a[i]) * dt2;
+                    previous[i] = current;
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    void Particles<T>::SemiImplicitEuler(Vector2SoA<T> positions, Vector2SoA<T> velocities, Vector2SoA<const T> accelerations,
+        const Vector2<T>& gravity, const T& damping, const T& dt) noexcept
+    {
+        const bool accelerated = accelerations.size != 0;
+        SemiImplicitEuler<2>({positions.x, positions.y}, {velocities.x, velocities.y},
+            {accelerated ? accelerations.x : nullptr, accelerated ? accelerations.y : nullptr}, {gravity.x, gravity.y},
+            damping, dt, positions.size);
+    }
+
+    template<typename T>
+    void Particles<T>::SemiImplicitEuler(Vector3SoA<T> positions, Vector3SoA<T> velocities, Vector3SoA<const T> accelerations,
+        const Vector3<T>& gravity, const T& damping, const T& dt) noexcept
+    {
+        const bool accelerated = accelerations.size != 0;
+        SemiImplicitEuler<3>({positions.x, positions.y, positions.z}, {velocities.x, velocities.y, velocities.z},
+            {accelerated ? accelerations.x : nullptr, accelerated ? accelerations.y : nullptr, accelerated ? accelerations.z : nullptr},
+            {gravity.x, gravity.y, gravity.z}, damping, dt, positions.size);
+    }
+
+    template<typename T>
+    void Particles<T>::SemiImplicitEuler(const Execution& execution, Vector2SoA<T> positions, Vector2SoA<T> velocities, Vector2SoA<const T> accelerations,
+        const Vector2<T>& gravity, const T& damping, const T& dt)
+    {
+        Parallel::For(positions.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            SemiImplicitEuler(positions.Slice(begin, end - begin), velocities.Slice(begin, end - begin),
+                accelerations.size != 0 ? accelerations.Slice(begin, end - begin) : accelerations, gravity, damping, dt);
+        }, execution);
+    }
+
+    template<typename T>
+    void Particles<T>::SemiImplicitEuler(const Execution& execution, Vector3SoA<T> positions, Vector3SoA<T> velocities, Vector3SoA<const T> accelerations,
+        const Vector3<T>& gravity, const T& damping, const T& dt)
+    {
+        Parallel::For(positions.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            SemiImplicitEuler(positions.Slice(begin, end - begin), velocities.Slice(begin, end - begin),
+                accelerations.size != 0 ? accelerations.Slice(begin, end - begin) : accelerations, gravity, damping, dt);
+        }, execution);
+    }
+
+    template<typename T>
+    void Particles<T>::Verlet(Vector2SoA<T> positions, Vector2SoA<T> previous_positions, Vector2SoA<const T> accelerations,
+        const Vector2<T>& gravity, const T& damping, const T& dt) noexcept
+    {
+        const bool accelerated = accelerations.size != 0;
+        Verlet<2>({positions.x, positions.y}, {previous_positions.x, previous_positions.y},
+            {accelerated ? accelerations.x : nullptr, accelerated ? accelerations.y : nullptr}, {gravity.x, gravity.y},
+            damping, dt, positions.size);
+    }
+
+    template<typename T>
+    void Particles<T>::Verlet(Vector3SoA<T> positions, Vector3SoA<T> previous_positions, Vector3SoA<const T> accelerations,
+        const Vector3<T>& gravity, const T& damping, const T& dt) noexcept
+    {
+        const bool accelerated = accelerations.size != 0;
+        Verlet<3>({positions.x, positions.y, positions.z}, {previous_positions.x, previous_positions.y, previous_positions.z},
+            {accelerated ? accelerations.x : nullptr, accelerated ? accelerations.y : nullptr, accelerated ? accelerations.z : nullptr},
+            {gravity.x, gravity.y, gravity.z}, damping, dt, positions.size);
+    }
+
+    template<typename T>
+    void Particles<T>::Verlet(const Execution& execution, Vector2SoA<T> positions, Vector2SoA<T> previous_positions, Vector2SoA<const T> accelerations,
+        const Vector2<T>& gravity, const T& damping, const T& dt)
+    {
+        Parallel::For(positions.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Verlet(positions.Slice(begin, end - begin), previous_positions.Slice(begin, end - begin),
+                accelerations.size != 0 ? accelerations.Slice(begin, end - begin) : accelerations, gravity, damping, dt);
+        }, execution);
+    }
+
+    template<typename T>
+    void Particles<T>::Verlet(const Execution& execution, Vector3SoA<T> positions, Vector3SoA<T> previous_positions, Vector3SoA<const T> accelerations,
+        const Vector3<T>& gravity, const T& damping, const T& dt)
+    {
+        Parallel::For(positions.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Verlet(positions.Slice(begin, end - begin), previous_positions.Slice(begin, end - begin),
+                accelerations.size != 0 ? accelerations.Slice(begin, end - begin) : accelerations, gravity, damping, dt);
+        }, execution);
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    T Particles<T>::CorrectionLane(const T& length2, const T& rest_length, const T& inverse_mass_sum, const T& stiffness) noexcept
+    {
+        // (length - rest_length) / (length * inverse_mass_sum), the selects keep the division finite
+        const bool valid = length2 > 0 && inverse_mass_sum > 0;
+        const T length = std::sqrt(length2);
+        const T denominator = valid ? length * inverse_mass_sum : T(1);
+        const T scale = stiffness * (length - rest_length) / denominator;
+        return valid ? scale : T(0);
+    }
+
+    template<typename T>
+    template<std::size_t dimensions>
+    void Particles<T>::ProjectDistances(const std::array<T*, dimensions>& positions, const T* inverse_masses,
+        const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t count, const T& stiffness) noexcept
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const std::uint32_t a = first[i];
+            const std::uint32_t b = second[i];
+            std::array<T, dimensions> d;
+            T length2 = T(0);
+            for(std::size_t c = 0; c < dimensions; ++c)
+            {
+                d[c] = positions[c][b] - positions[c][a];
+                length2 += d[c] * d[c];
+            }
+            const T scale = CorrectionLane(length2, rest_lengths[i], inverse_masses[a] + inverse_masses[b], stiffness);
+            const T scale_a = scale * inverse_masses[a];
+            const T scale_b = scale * inverse_masses[b];
+            for(std::size_t c = 0; c < dimensions; ++c)
+            {
+                positions[c][a] += d[c] * scale_a;
+                positions[c][b] -= d[c] * scale_b;
+            }
+        }
+    }
+
+    template<typename T>
+    template<std::size_t dimensions>
+    void Particles<T>::ProjectIndependent(const std::array<T*, dimensions>& positions, const T* inverse_masses,
+        const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t begin, std::size_t end,
+        const T& stiffness) noexcept
+    {
+        // gathered into local tiles, the corrections run in simd lanes and are scattered back.
+        // no particle is touched twice, so the order of the scatter does not matter
+        T d[dimensions][tile];
+        T scale_a[tile];
+        T scale_b[tile];
+        for(std::size_t tile_begin = begin; tile_begin < end; tile_begin += tile)
+        {
+            const std::size_t size = std::min(tile, end - tile_begin);
+            const std::uint32_t* a = first + tile_begin;
+            const std::uint32_t* b = second + tile_begin;
+            for(std::size_t c = 0; c < dimensions; ++c)
+            {
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    d[c][i] = positions[c][b[i]] - positions[c][a[i]];
+                }
+            }
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                scale_a[i] = inverse_masses[a[i]];
+                scale_b[i] = inverse_masses[b[i]];
+            }
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                T length2 = T(0);
+                for(std::size_t c = 0; c < dimensions; ++c)
+                {
+                    length2 += d[c][i] * d[c][i];
+                }
+                const T scale = CorrectionLane(length2, rest_lengths[tile_begin + i], scale_a[i] + scale_b[i], stiffness);
+                scale_a[i] *= scale;
+                scale_b[i] *= scale;
+            }
+            for(std::size_t c = 0; c < dimensions; ++c)
+            {
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    positions[c][a[i]] += d[c][i] * scale_a[i];
+                    positions[c][b[i]] -= d[c][i] * scale_b[i];
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    template<std::size_t dimensions>
+    void Particles<T>::ProjectDistances(const Execution& execution, const std::array<T*, dimensions>& positions, const T* inverse_masses,
+        const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, const std::vector<std::size_t>& colors, const T& stiffness)
+    {
+        // colors are separated by the join of Parallel::For
+        for(std::size_t color = 0; color + 1 < colors.size(); ++color)
+        {
+            const std::size_t offset = colors[color];
+            Parallel::For(colors[color + 1] - offset, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+            {
+                ProjectIndependent(positions, inverse_masses, first, second, rest_lengths, offset + begin, offset + end, stiffness);
+            }, execution);
+        }
+    }
+
+    template<typename T>
+    void Particles<T>::ProjectDistances(Vector2SoA<T> positions, const T* inverse_masses,
+        const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t count, const T& stiffness) noexcept
+    {
+        ProjectDistances<2>({positions.x, positions.y}, inverse_masses, first, second, rest_lengths, count, stiffness);
+    }
+
+    template<typename T>
+    void Particles<T>::ProjectDistances(Vector3SoA<T> positions, const T* inverse_masses,
+        const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, std::size_t count, const T& stiffness) noexcept
+    {
+        ProjectDistances<3>({positions.x, positions.y, positions.z}, inverse_masses, first, second, rest_lengths, count, stiffness);
+    }
+
+    template<typename T>
+    void Particles<T>::ProjectDistances(const Execution& execution, Vector2SoA<T> positions, const T* inverse_masses,
+        const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, const std::vector<std::size_t>& colors, const T& stiffness)
+    {
+        ProjectDistances<2>(execution, {positions.x, positions.y}, inverse_masses, first, second, rest_lengths, colors, stiffness);
+    }
+
+    template<typename T>
+    void Particles<T>::ProjectDistances(const Execution& execution, Vector3SoA<T> positions, const T* inverse_masses,
+        const std::uint32_t* first, const std::uint32_t* second, const T* rest_lengths, const std::vector<std::size_t>& colors, const T& stiffness)
+    {
+        ProjectDistances<3>(execution, {positions.x, positions.y, positions.z}, inverse_masses, first, second, rest_lengths, colors, stiffness);
+    }
+
+//==============================================================================================================================================
+
+    template<typename T>
+    std::vector<std::size_t> Particles<T>::ColorConstraints(std::uint32_t* first, std::uint32_t* second, T* rest_lengths, std::size_t count,
+        std::size_t particle_count)
+    {
+        // every round takes the remaining constraints whose particles are still free in this round
+        const std::size_t free = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> taken_in(particle_count, free);
+        std::vector<std::size_t> remaining(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            if(first[i] >= particle_count || second[i] >= particle_count || first[i] == second[i])
+            {
+                throw std::runtime_error("constraint has an invalid pair of particles");
+            }
+            remaining[i] = i;
+        }
+
+        std::vector<std::size_t> order;
+        order.reserve(count);
+        std::vector<std::size_t> colors = { 0 };
+        for(std::size_t round = 0; !remaining.empty(); ++round)
+        {
+            std::size_t kept = 0;
+            for(std::size_t i : remaining)
+            {
+                if(taken_in[first[i]] != round && taken_in[second[i]] != round)
+                {
+                    taken_in[first[i]] = round;
+                    taken_in[second[i]] = round;
+                    order.push_back(i);
+                }
+                else
+                {
+                    remaining[kept++] = i;
+                }
+            }
+            remaining.resize(kept);
+            colors.push_back(order.size());
+        }
+
+        const std::vector<std::uint32_t> old_first(first, first + count);
+        const std::vector<std::uint32_t> old_second(second, second + count);
+        const std::vector<T> old_rest_lengths(rest_lengths, rest_lengths + count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            first[i] = old_first[order[i]];
+            second[i] = old_second[order[i]];
+            rest_lengths[i] = old_rest_lengths[order[i]];
+        }
+        return colors;
+    }
+
+} // namespace linal
@@ -0,0 +1,223 @@
+#pragma once
+#include "Linal.h"
+#include <algorithm>
+
+namespace linal
+{
+    template<typename T>
+    PointStatistics3<T>& PointStatistics3<T>::Add(const Vector3<T>& point) noexcept
+    {
+        ++count;
+        Vector3<T> delta = point - mean;
+        mean += delta * (T(1) / static_cast<T>(count));
+        Vector3<T> delta_after = point - mean;
+        comoment.line0 += delta_after * delta.x;
+        comoment.line1 += delta_after * delta.y;
+        comoment.line2 += delta_after * delta.z;
+
+        lower = { std::min(lower.x, point.x), std::min(lower.y, point.y), std::min(lower.z, point.z) };
+        upper = { std::max(upper.x, point.x), std::max(upper.y, point.y), std::max(upper.z, point.z) };
+        return *this;
+    }
+
+    template<typename T>
+    PointStatistics3<T>& PointStatistics3<T>::Merge(const PointStatistics3<T>& other) noexcept
+    {
+        if(other.count == 0)
+        {
+            return *this;
+        }
+        if(count == 0)
+        {
+            return *this = other;
+        }
+
+        T n_a = static_cast<T>(count);
+        T n_b = static_cast<T>(other.count);
+        T n = n_a + n_b;
+        Vector3<T> delta = other.mean - mean;
+
+        mean += delta * (n_b / n);
+        T weight = n_a * n_b / n;
+        comoment += other.comoment;
+        comoment.line0 += delta * (delta.x * weight);
+        comoment.line1 += delta * (delta.y * weight);
+        comoment.line2 += delta * (delta.z * weight);
+        count += other.count;
+
+        lower = { std::min(lower.x, other.lower.x), std::min(lower.y, other.lower.y), std::min(lower.z, other.lower.z) };
+        upper = { std::max(upper.x, other.upper.x), std::max(upper.y, other.upper.y), std::max(upper.z, other.upper.z) };
+        return *this;
+    }
+
+    template<typename T>
+    Matrix3x3<T> PointStatistics3<T>::Covariance() const noexcept
+    {
+        if(count == 0)
+        {
+            return Matrix3x3<T>::zero;
+        }
+        return comoment * (T(1) / static_cast<T>(count));
+    }
+
+    template<typename T>
+    Matrix3x3<T> PointStatistics3<T>::SampleCovariance() const noexcept
+    {
+        if(count < 2)
+        {
+            return Matrix3x3<T>::zero;
+        }
+        return comoment * (T(1) / static_cast<T>(count - 1));
+    }
+
+    template<typename T>
+    std::pair<Vector3<T>, Rotator3<T>> PointStatistics3<T>::PrincipalAxes() const noexcept
+    {
+        return Covariance().EigenSymmetric();
+    }
+
+    template<typename T>
+    template<bool compensated>
+    PointStatistics3<T> PointStatistics3<T>::Accumulate(Vector3SoA<const T> points) noexcept
+    {
+        PointStatistics3<T> result;
+        if(points.size == 0)
+        {
+            return result;
+        }
+
+        // independent accumulators per lane, so the main loop vectorizes
+        constexpr std::size_t lanes = 8;
+        constexpr std::size_t sums = 9;
+        T sum[sums][lanes] = {};
+        T error[sums][lanes] = {};
+        T low[3][lanes];
+        T high[3][lanes];
+        const Vector3<T> shift = points.Get(0);
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            low[0][l] = high[0][l] = shift.x;
+            low[1][l] = high[1][l] = shift.y;
+            low[2][l] = high[2][l] = shift.z;
+        }
+
+        auto lane = [&](std::size_t l, const T& x, const T& y, const T& z)
+        {
+            const T dx = x - shift.x;
+            const T dy = y - shift.y;
+            const T dz = z - shift.z;
+            const T value[sums] = { dx, dy, dz, dx * dx, dx * dy, dx * dz, dy * dy, dy * dz, dz * dz };
+            for(std::size_t s = 0; s < sums; ++s)
+            {
+                if constexpr(compensated)
+                {
+                    const T y_value = value[s] - error[s][l];
+                    const T t = sum[s][l] + y_value;
+                    error[s][l] = (t - sum[s][l]) - y_value;
+                    sum[s][l] = t;
+                }
+                else
+                {
+                    sum[s][l] += value[s];
+                }
+            }
+            low[0][l] = std::min(low[0][l], x);
+            low[1][l] = std::min(low[1][l], y);
+            low[2][l] = std::min(low[2][l], z);
+            high[0][l] = std::max(high[0][l], x);
+            high[1][l] = std::max(high[1][l], y);
+            high[2][l] = std::max(high[2][l], z);
+        };
+
+        std::size_t i = 0;
+        for(; i + lanes <= points.size; i += lanes)
+        {
+            for(std::size_t l = 0; l < lanes; ++l)
+            {
+                lane(l, points.x[i + l], points.y[i + l], points.z[i + l]);
+            }
+        }
+        for(std::size_t l = 0; i < points.size; ++i, ++l)
+        {
+            lane(l, points.x[i], points.y[i], points.z[i]);
+        }
+
+        T total[sums] = {};
+        for(std::size_t s = 0; s < sums; ++s)
+        {
+            for(std::size_t l = 0; l < lanes; ++l)
+            {
+                total[s] += sum[s][l];
+            }
+        }
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            result.lower = { std::min(result.lower.x, low[0][l]), std::min(result.lower.y, low[1][l]), std::min(result.lower.z, low[2][l]) };
+            result.upper = { std::max(result.upper.x, high[0][l]), std::max(result.upper.y, high[1][l]), std::max(result.upper.z, high[2][l]) };
+        }
+
+        // sums of shifted points to mean and comoment: M = S2 - S1 * S1^T / n
+        const T n = static_cast<T>(points.size);
+        const Vector3<T> s1 = { total[0], total[1], total[2] };
+        result.count = points.size;
+        result.mean = shift + s1 * (T(1) / n);
+        result.comoment =
+        {
+            { total[3], total[4], total[5] },
+            { total[4], total[6], total[7] },
+            { total[5], total[7], total[8] }
+        };
+        result.comoment.line0 -= s1 * (s1.x / n);
+        result.comoment.line1 -= s1 * (s1.y / n);
+        result.comoment.line2 -= s1 * (s1.z / n);
+        return result;
+    }
+
+    template<typename T>
+    PointStatistics3<T> PointStatistics3<T>::AccumulatePairwise(Vector3SoA<const T> points) noexcept
+    {
+        if(points.size <= pairwise_block_size)
+        {
+            return Accumulate<false>(points);
+        }
+        std::size_t half = points.size / 2;
+        return AccumulatePairwise(points.Slice(0, half)).Merge(AccumulatePairwise(points.Slice(half, points.size - half)));
+    }
+
+    template<typename T>
+    PointStatistics3<T> PointStatistics3<T>::Compute(Vector3SoA<const T> points, Summation summation, const Execution& execution)
+    {
+        // the blocks do not depend on the execution, and they are merged in order
+        std::size_t blocks = (points.size + block_size - 1) / block_size;
+        std::vector<PointStatistics3<T>> partial(blocks);
+        Parallel::For(blocks, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t b = begin; b < end; ++b)
+            {
+                Vector3SoA<const T> block = points.Slice(b * block_size, std::min(block_size, points.size - b * block_size));
+                switch(summation)
+                {
+                case Summation::kahan:
+                    partial[b] = Accumulate<true>(block);
+                    break;
+                case Summation::pairwise:
+                    partial[b] = AccumulatePairwise(block);
+                    break;
+                default:
+                    partial[b] = Accumulate<false>(block);
+                    break;
+                }
+            }
+        }, execution);
+
+        // pairwise merge of the blocks, every step halves the number of partial results
+        for(std::size_t step = 1; step < blocks; step *= 2)
+        {
+            for(std::size_t b = 0; b + step < blocks; b += 2 * step)
+            {
+                partial[b].Merge(partial[b + step]);
+            }
+        }
+        return blocks != 0 ? partial[0] : PointStatistics3<T>{};
+    }
+} // namespace linal
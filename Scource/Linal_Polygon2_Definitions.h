@@ -0,0 +1,346 @@
+#pragma once
+#include "Linal.h"
+
+#include <algorithm>
+
+namespace linal
+{
+    template<typename T>
+    std::vector<std::uint32_t> Polygon2<T>::ConvexHull(Vector2SoA<const T> points, const Execution& execution)
+    {
+        if(points.size > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error("too many points for convex hull");
+        }
+        if(points.size == 0)
+        {
+            return {};
+        }
+
+        // the blocks do not depend on the execution
+        std::size_t blocks = (points.size + block_size - 1) / block_size;
+        std::vector<std::array<std::uint32_t, 8>> block_extremes(blocks);
+        Parallel::For(blocks, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t b = begin; b < end; ++b)
+            {
+                block_extremes[b] = Extremes(points.Slice(b * block_size, std::min(block_size, points.size - b * block_size)), b * block_size);
+            }
+        }, execution);
+
+        // a later block wins only with a larger projection, so ties keep the lowest index
+        std::array<std::uint32_t, 8> extremes = block_extremes[0];
+        for(std::size_t b = 1; b < blocks; ++b)
+        {
+            for(std::size_t k = 0; k < 8; ++k)
+            {
+                Vector2<T> candidate = points.Get(block_extremes[b][k]);
+                Vector2<T> best = points.Get(extremes[k]);
+                if(Projections(candidate.x, candidate.y)[k] > Projections(best.x, best.y)[k])
+                {
+                    extremes[k] = block_extremes[b][k];
+                }
+            }
+        }
+        std::array<Vector2<T>, 8> octagon;
+        for(std::size_t k = 0; k < 8; ++k)
+        {
+            octagon[k] = points.Get(extremes[k]);
+        }
+
+        // hulls of the points left in every block, then the hull of their vertices
+        std::vector<std::vector<std::uint32_t>> block_hulls(blocks);
+        Parallel::For(blocks, 1, [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<std::uint8_t> keep(block_size);
+            for(std::size_t b = begin; b < end; ++b)
+            {
+                std::size_t offset = b * block_size;
+                std::size_t count = std::min(block_size, points.size - offset);
+                Filter(points.Slice(offset, count), octagon, keep.data());
+
+                std::vector<std::uint32_t> indices;
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    if(keep[i] != 0)
+                    {
+                        indices.push_back(static_cast<std::uint32_t>(offset + i));
+                    }
+                }
+                block_hulls[b] = Chain(points, std::move(indices));
+            }
+        }, execution);
+
+        if(blocks == 1)
+        {
+            return std::move(block_hulls[0]);
+        }
+        std::vector<std::uint32_t> vertices;
+        for(const std::vector<std::uint32_t>& hull : block_hulls)
+        {
+            vertices.insert(vertices.end(), hull.begin(), hull.end());
+        }
+        return Chain(points, std::move(vertices));
+    }
+
+    template<typename T>
+    T Polygon2<T>::Area(Vector2SoA<const T> polygon) noexcept
+    {
+        return DoubleArea(polygon) / T(2);
+    }
+
+    template<typename T>
+    Vector2<T> Polygon2<T>::Centroid(Vector2SoA<const T> polygon) noexcept
+    {
+        if(polygon.size == 0)
+        {
+            return { 0, 0 };
+        }
+        Vector2<T> moment;
+        T double_area = DoubleArea(polygon, moment);
+        if(double_area != T(0))
+        {
+            return polygon.Get(0) + moment / (T(3) * double_area);
+        }
+
+        Vector2<T> origin = polygon.Get(0);
+        Vector2<T> sum;
+        for(std::size_t i = 1; i < polygon.size; ++i)
+        {
+            sum += polygon.Get(i) - origin;
+        }
+        return origin + sum / T(polygon.size);
+    }
+
+    template<typename T>
+    void Polygon2<T>::Areas(Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count, T* areas) noexcept
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            areas[i] = Area(vertices.Slice(offsets[i], offsets[i + 1] - offsets[i]));
+        }
+    }
+
+    template<typename T>
+    void Polygon2<T>::Centroids(Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count, Vector2SoA<T> centroids) noexcept
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            centroids.Set(i, Centroid(vertices.Slice(offsets[i], offsets[i + 1] - offsets[i])));
+        }
+    }
+
+    template<typename T>
+    void Polygon2<T>::Areas(const Execution& execution, Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count, T* areas)
+    {
+        Parallel::For(count, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Areas(vertices, offsets + begin, end - begin, areas + begin);
+        }, execution);
+    }
+
+    template<typename T>
+    void Polygon2<T>::Centroids(const Execution& execution, Vector2SoA<const T> vertices, const std::uint32_t* offsets, std::size_t count,
+        Vector2SoA<T> centroids)
+    {
+        Parallel::For(count, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Centroids(vertices, offsets + begin, end - begin, centroids.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    std::array<T, 8> Polygon2<T>::Projections(const T& x, const T& y) noexcept
+    {
+        return { x, x + y, y, y - x, -x, -x - y, -y, x - y };
+    }
+
+    template<typename T>
+    std::array<std::uint32_t, 8> Polygon2<T>::Extremes(Vector2SoA<const T> points, std::size_t offset) noexcept
+    {
+        // the maxima are branch free selects, the indices are searched afterwards
+        std::array<T, 8> maxima = Projections(points.x[0], points.y[0]);
+        for(std::size_t i = 1; i < points.size; ++i)
+        {
+            std::array<T, 8> projections = Projections(points.x[i], points.y[i]);
+            for(std::size_t k = 0; k < 8; ++k)
+            {
+                maxima[k] = projections[k] > maxima[k] ? projections[k] : maxima[k];
+            }
+        }
+
+        std::array<std::uint32_t, 8> extremes;
+        for(std::size_t k = 0; k < 8; ++k)
+        {
+            std::size_t i = 0;
+            while(i + 1 < points.size && Projections(points.x[i], points.y[i])[k] != maxima[k])
+            {
+                ++i;
+            }
+            extremes[k] = static_cast<std::uint32_t>(offset + i);
+        }
+        return extremes;
+    }
+
+    template<typename T>
+    void Polygon2<T>::Filter(Vector2SoA<const T> points, const std::array<Vector2<T>, 8>& octagon, std::uint8_t* keep) noexcept
+    {
+        // edges between equal extremes do not reject anything, unless all of them are like that
+        std::array<Vector2<T>, 8> edges;
+        std::array<std::uint8_t, 8> degenerate;
+        bool any_edge = false;
+        for(std::size_t k = 0; k < 8; ++k)
+        {
+            edges[k] = octagon[(k + 1) % 8] - octagon[k];
+            degenerate[k] = edges[k].x == T(0) && edges[k].y == T(0);
+            any_edge = any_edge || degenerate[k] == 0;
+        }
+        for(std::size_t k = 0; k < 8; ++k)
+        {
+            degenerate[k] = degenerate[k] & std::uint8_t(any_edge);
+        }
+
+        for(std::size_t i = 0; i < points.size; ++i)
+        {
+            std::uint8_t inside = 1;
+            for(std::size_t k = 0; k < 8; ++k)
+            {
+                T turn = edges[k].OrthogonalL().Dot(points.Get(i) - octagon[k]);
+                inside &= std::uint8_t(turn > T(0)) | degenerate[k];
+            }
+            keep[i] = inside ^ 1;
+        }
+    }
+
+    template<typename T>
+    std::vector<std::uint32_t> Polygon2<T>::Chain(Vector2SoA<const T> points, std::vector<std::uint32_t> indices)
+    {
+        std::sort(indices.begin(), indices.end(), [&](std::uint32_t a, std::uint32_t b)
+        {
+            if(points.x[a] != points.x[b])
+            {
+                return points.x[a] < points.x[b];
+            }
+            if(points.y[a] != points.y[b])
+            {
+                return points.y[a] < points.y[b];
+            }
+            return a < b;
+        });
+        indices.erase(std::unique(indices.begin(), indices.end(), [&](std::uint32_t a, std::uint32_t b)
+        {
+            return points.x[a] == points.x[b] && points.y[a] == points.y[b];
+        }), indices.end());
+        if(indices.size() < 2)
+        {
+            return indices;
+        }
+
+        // lower chain left to right, then upper chain right to left, popping every vertex that does not turn left
+        auto turn = [&](std::uint32_t o, std::uint32_t a, std::uint32_t b)
+        {
+            Vector2<T> origin = points.Get(o);
+            return (points.Get(a) - origin).OrthogonalL().Dot(points.Get(b) - origin);
+        };
+        std::vector<std::uint32_t> hull(2 * indices.size());
+        std::size_t size = 0;
+        for(std::size_t i = 0; i < indices.size(); ++i)
+        {
+            while(size >= 2 && turn(hull[size - 2], hull[size - 1], indices[i]) <= T(0))
+            {
+                --size;
+            }
+            hull[size++] = indices[i];
+        }
+        for(std::size_t i = indices.size() - 1, lower = size + 1; i-- > 0;)
+        {
+            while(size >= lower && turn(hull[size - 2], hull[size - 1], indices[i]) <= T(0))
+            {
+                --size;
+            }
+            hull[size++] = indices[i];
+        }
+        // the last vertex is the first one again
+        hull.resize(size - 1);
+        return hull;
+    }
+
+    template<typename T>
+    T Polygon2<T>::DoubleArea(Vector2SoA<const T> polygon) noexcept
+    {
+        if(polygon.size < 3)
+        {
+            return T(0);
+        }
+        // fan around the first vertex, edges touching it add nothing. the sums are split in lanes so they vectorize
+        Vector2<T> origin = polygon.Get(0);
+        std::size_t edges = polygon.size - 2;
+        std::size_t full = edges - edges % lanes;
+        T sums[lanes] = {};
+        for(std::size_t e = 0; e < full; e += lanes)
+        {
+            for(std::size_t l = 0; l < lanes; ++l)
+            {
+                std::size_t i = 1 + e + l;
+                sums[l] += (polygon.Get(i) - origin).OrthogonalL().Dot(polygon.Get(i + 1) - origin);
+            }
+        }
+        for(std::size_t e = full; e < edges; ++e)
+        {
+            sums[0] += (polygon.Get(1 + e) - origin).OrthogonalL().Dot(polygon.Get(2 + e) - origin);
+        }
+
+        T sum = 0;
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            sum += sums[l];
+        }
+        return sum;
+    }
+
+    template<typename T>
+    T Polygon2<T>::DoubleArea(Vector2SoA<const T> polygon, Vector2<T>& moment) noexcept
+    {
+        moment = { 0, 0 };
+        if(polygon.size < 3)
+        {
+            return T(0);
+        }
+        // every fan triangle adds its double area times the sum of its vertices relative to the first one
+        Vector2<T> origin = polygon.Get(0);
+        std::size_t edges = polygon.size - 2;
+        std::size_t full = edges - edges % lanes;
+        T sums[lanes] = {};
+        T moments_x[lanes] = {};
+        T moments_y[lanes] = {};
+        auto add = [&](std::size_t l, std::size_t i)
+        {
+            Vector2<T> a = polygon.Get(i) - origin;
+            Vector2<T> b = polygon.Get(i + 1) - origin;
+            T cross = a.OrthogonalL().Dot(b);
+            sums[l] += cross;
+            moments_x[l] += cross * (a.x + b.x);
+            moments_y[l] += cross * (a.y + b.y);
+        };
+        for(std::size_t e = 0; e < full; e += lanes)
+        {
+            for(std::size_t l = 0; l < lanes; ++l)
+            {
+                add(l, 1 + e + l);
+            }
+        }
+        for(std::size_t e = full; e < edges; ++e)
+        {
+            add(0, 1 + e);
+        }
+
+        T sum = 0;
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            sum += sums[l];
+            moment.x += moments_x[l];
+            moment.y += moments_y[l];
+        }
+        return sum;
+    }
+} // namespace linal
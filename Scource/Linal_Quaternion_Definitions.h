@@ -82,8 +82,8 @@ namespace linal
                 Vector3<T>{ T(1) - yy2 - zz2,        xy2 - wz2,        zx2 + wy2 },
                 Vector3<T>{        xy2 + wz2, T(1) - zz2 - xx2,        yz2 - wx2 },
                 Vector3<T>{        zx2 - wy2,        yz2 + wx2, T(1) - xx2 - yy2 },
-            };
-        }
+            }
+        };
     }
 
     template<typename T>
@@ -148,7 +148,7 @@ namespace linal
     template<typename T>
     Rotator3<T> Quaternion<T>::Normalized() const
     {
-        return Quaternion<T>(*this).Normalize();
+        return Rotator3<T>(Quaternion<T>(*this).Normalize());
     }
 
     // sqrt_calculator should have method "Sqrt(const T&) -> T&&"
@@ -163,7 +163,7 @@ namespace linal
     template<typename MathT>
     Rotator3<T> Quaternion<T>::Normalized(MathT&& sqrt_calculator) const
     {
-        return Quaternion<T>(*this).Normalize(std::forward(sqrt_calculator));
+        return Rotator3<T>(Quaternion<T>(*this).Normalize(std::forward<MathT>(sqrt_calculator)));
     }
 
     template<typename T>
@@ -0,0 +1,42 @@
+#pragma once
+#include "Linal.h"
+
+namespace linal
+{
+    template<typename T>
+    RotMatrix3x3<T>::RotMatrix3x3(const Matrix3x3<T>& matrix) noexcept : value(matrix) {}
+
+    template<typename T>
+    RotMatrix3x3<T> RotMatrix3x3<T>::operator*(const RotMatrix3x3<T>& other) const noexcept
+    {
+        return RotMatrix3x3<T>(value * other.value);
+    }
+
+    template<typename T>
+    RotMatrix3x3<T>& RotMatrix3x3<T>::Inverse() noexcept
+    {
+        value = value.Transposed();
+        return *this;
+    }
+
+    template<typename T>
+    RotMatrix3x3<T> RotMatrix3x3<T>::Inversed() const noexcept
+    {
+        return RotMatrix3x3<T>(*this).Inverse();
+    }
+
+    template<typename T>
+    const Matrix3x3<T>& RotMatrix3x3<T>::AsMatrix() const noexcept
+    {
+        return value;
+    }
+
+    template<typename T>
+    RotMatrix3x3<T>::operator const Matrix3x3<T>& () const noexcept
+    {
+        return AsMatrix();
+    }
+
+    template<typename T>
+    const RotMatrix3x3<T> RotMatrix3x3<T>::identity = RotMatrix3x3<T>(Matrix3x3<T>::one);
+}
@@ -218,12 +218,25 @@ namespace linal
         return Rotator2<T>{Complex<T>{sin_cos_calculator.Cos(angle), sin_cos_calculator.Sin(angle)}};
     }
 
+    template<typename T>
+    void Rotator2<T>::FromToLane(const T& from_x, const T& from_y, const T& to_x, const T& to_y, T& re, T& im) noexcept
+    {
+        // to * conjugate(from), its length is |from| * |to|
+        const T x = from_x * to_x + from_y * to_y;
+        const T y = from_x * to_y - from_y * to_x;
+        const T length2 = x * x + y * y;
+        const bool valid = length2 > 0;
+        const T inv = T(1) / std::sqrt(valid ? length2 : T(1));
+        re = valid ? x * inv : T(1);
+        im = valid ? y * inv : T(0);
+    }
+
     template<typename T>
     Rotator2<T> Rotator2<T>::FromTo(const Vector2<T>& from, const Vector2<T>& to) noexcept
     {
-        Rotator2 result = to.AsComplex() / from.AsComplex();
-        result.Repair();
-        return result;
+        Complex<T> result;
+        FromToLane(from.x, from.y, to.x, to.y, result.re, result.im);
+        return Rotator2<T>(result);
     }
 
     template<typename T>
@@ -236,9 +249,47 @@ namespace linal
     template<typename MathT>
     Rotator2<T> Rotator2<T>::FromTo(const Vector2<T>& from, const Vector2<T>& to, MathT&& sqrt_calculator) noexcept
     {
-        Rotator2 result = to.AsComplex() / from.AsComplex();
-        result.Repair(std::forward(sqrt_calculator));
-        return result;
+        const T x = from.Dot(to);
+        const T y = from.x * to.y - from.y * to.x;
+        const T length2 = x * x + y * y;
+        if(length2 == 0)
+        {
+            return identity;
+        }
+        const T inv = T(1) / sqrt_calculator.Sqrt(length2);
+        return Rotator2<T>(Complex<T>{ x * inv, y * inv });
+    }
+
+    template<typename T>
+    Rotator2<T> Rotator2<T>::HalfFromTo(const Direction2<T>& from, const Direction2<T>& to) noexcept
+    {
+        const Vector2<T>& a = from.AsVect();
+        const Vector2<T>& b = to.AsVect();
+        // 1 + to * conjugate(from) points at half of the angle
+        const T x = 1 + a.Dot(b);
+        const T y = a.x * b.y - a.y * b.x;
+        const T length2 = x * x + y * y;
+        const bool valid = length2 > 0;
+        const T inv = T(1) / std::sqrt(valid ? length2 : T(1));
+        return Rotator2<T>(Complex<T>{ valid ? x * inv : T(0), valid ? y * inv : T(1) });
+    }
+
+    template<typename T>
+    void Rotator2<T>::FromTo(Vector2SoA<const T> from, Vector2SoA<const T> to, ComplexSoA<T> rotators) noexcept
+    {
+        for(std::size_t i = 0; i < from.size; ++i)
+        {
+            FromToLane(from.x[i], from.y[i], to.x[i], to.y[i], rotators.re[i], rotators.im[i]);
+        }
+    }
+
+    template<typename T>
+    void Rotator2<T>::FromTo(const Execution& execution, Vector2SoA<const T> from, Vector2SoA<const T> to, ComplexSoA<T> rotators)
+    {
+        Parallel::For(from.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            FromTo(from.Slice(begin, end - begin), to.Slice(begin, end - begin), rotators.Slice(begin, end - begin));
+        }, execution);
     }
 
 }
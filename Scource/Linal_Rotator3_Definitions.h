@@ -0,0 +1,389 @@
+#pragma once
+#include "Linal.h"
+#include <cmath>
+#include <limits>
+
+namespace linal
+{
+    template<typename T>
+    Rotator3<T>::Rotator3(const Quaternion<T>& quaternion) noexcept : value(quaternion) {}
+
+    template<typename T>
+    Rotator3<T>::Rotator3(Quaternion<T>&& quaternion) noexcept : value(std::move(quaternion)) {}
+
+    template<typename T>
+    const T& Rotator3<T>::GetRe() const noexcept
+    {
+        return value.re;
+    }
+
+    template<typename T>
+    const Vector3<T>& Rotator3<T>::GetIm() const noexcept
+    {
+        return value.im;
+    }
+
+    template<typename T>
+    const Quaternion<T>& Rotator3<T>::AsQuaternion() const noexcept
+    {
+        return value;
+    }
+
+    template<typename T>
+    Rotator3<T>::operator const Quaternion<T>& () const noexcept
+    {
+        return AsQuaternion();
+    }
+
+    template<typename T>
+    RotMatrix3x3<T> Rotator3<T>::MakeMatrix() const noexcept
+    {
+        return value.MakeMatrix();
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::operator*(const Rotator3<T>& other) const noexcept
+    {
+        return Rotator3<T>(value * other.value);
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::operator/(const Rotator3<T>& other) const noexcept
+    {
+        return Rotator3<T>(value * other.value.Conjugate());
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::Inversed() const noexcept
+    {
+        return Rotator3<T>(value.Conjugate());
+    }
+
+    template<typename T>
+    Rotator3<T>& Rotator3<T>::RepairFast() noexcept
+    {
+        value *= T(1.5) - value.Abs2() / 2;
+        return *this;
+    }
+
+    template<typename T>
+    Rotator3<T>& Rotator3<T>::Repair()
+    {
+        value.Normalize();
+        return *this;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Rotator3<T>& Rotator3<T>::Repair(MathT&& sqrt_calculator)
+    {
+        value.Normalize(std::forward<MathT>(sqrt_calculator));
+        return *this;
+    }
+
+    template<typename T>
+    bool Rotator3<T>::operator==(const Rotator3<T>& other) const noexcept
+    {
+        return value == other.value;
+    }
+
+    template<typename T>
+    bool Rotator3<T>::operator!=(const Rotator3<T>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    template<typename T>
+    bool Rotator3<T>::Compare(const Rotator3<T>& other, const T& epsilon2) const noexcept
+    {
+        return value.Compare(other.value, epsilon2);
+    }
+
+    template<typename T>
+    const Rotator3<T> Rotator3<T>::identity = Rotator3<T>(Quaternion<T>{ 1, { 0, 0, 0 } });
+
+    template<typename T>
+    void Rotator3<T>::FromMatrixLane(
+        const T& m00, const T& m01, const T& m02,
+        const T& m10, const T& m11, const T& m12,
+        const T& m20, const T& m21, const T& m22,
+        T& re, T& x, T& y, T& z) noexcept
+    {
+        // every column of K is 4 * q[k] * q, the column with the largest diagonal is the best conditioned one
+        const T k_re[4] = { 1 + m00 + m11 + m22, m21 - m12, m02 - m20, m10 - m01 };
+        const T k_x[4] = { m21 - m12, 1 + m00 - m11 - m22, m01 + m10, m02 + m20 };
+        const T k_y[4] = { m02 - m20, m01 + m10, 1 - m00 + m11 - m22, m12 + m21 };
+        const T k_z[4] = { m10 - m01, m02 + m20, m12 + m21, 1 - m00 - m11 + m22 };
+
+        const bool x_over_re = k_x[1] > k_re[0];
+        const bool z_over_y = k_z[3] > k_y[2];
+        T first[4];
+        T second[4];
+        for(std::size_t c = 0; c < 4; ++c)
+        {
+            first[c] = x_over_re ? k_x[c] : k_re[c];
+            second[c] = z_over_y ? k_z[c] : k_y[c];
+        }
+        const T first_diagonal = x_over_re ? k_x[1] : k_re[0];
+        const T second_diagonal = z_over_y ? k_z[3] : k_y[2];
+        const bool use_second = second_diagonal > first_diagonal;
+
+        T q[4];
+        for(std::size_t c = 0; c < 4; ++c)
+        {
+            q[c] = use_second ? second[c] : first[c];
+        }
+        const T length2 = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+        const T scale = (q[0] < 0 ? T(-1) : T(1)) / std::sqrt(length2 > 0 ? length2 : T(1));
+        re = q[0] * scale;
+        x = q[1] * scale;
+        y = q[2] * scale;
+        z = q[3] * scale;
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::FromMatrix(const RotMatrix3x3<T>& matrix) noexcept
+    {
+        return FromMatrix(matrix.AsMatrix());
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::FromMatrix(const Matrix3x3<T>& matrix) noexcept
+    {
+        Quaternion<T> result;
+        FromMatrixLane(
+            matrix.line0.x, matrix.line0.y, matrix.line0.z,
+            matrix.line1.x, matrix.line1.y, matrix.line1.z,
+            matrix.line2.x, matrix.line2.y, matrix.line2.z,
+            result.re, result.im.x, result.im.y, result.im.z);
+        return Rotator3<T>(result);
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::FromTransform(const Transform3dUniform<T>& transform) noexcept
+    {
+        Quaternion<T> result;
+        FromMatrixLane(
+            transform[0], transform[1], transform[2],
+            transform[4], transform[5], transform[6],
+            transform[8], transform[9], transform[10],
+            result.re, result.im.x, result.im.y, result.im.z);
+        return Rotator3<T>(result);
+    }
+
+    template<typename T>
+    void Rotator3<T>::FromMatrix(const Matrix3x3<T>* matrices, QuaternionSoA<T> rotators) noexcept
+    {
+        for(std::size_t i = 0; i < rotators.size; ++i)
+        {
+            const Matrix3x3<T>& m = matrices[i];
+            FromMatrixLane(
+                m.line0.x, m.line0.y, m.line0.z,
+                m.line1.x, m.line1.y, m.line1.z,
+                m.line2.x, m.line2.y, m.line2.z,
+                rotators.re[i], rotators.x[i], rotators.y[i], rotators.z[i]);
+        }
+    }
+
+    template<typename T>
+    void Rotator3<T>::FromTransform(const Transform3dUniform<T>* transforms, QuaternionSoA<T> rotators) noexcept
+    {
+        for(std::size_t i = 0; i < rotators.size; ++i)
+        {
+            const T* t = transforms[i].data();
+            FromMatrixLane(
+                t[0], t[1], t[2],
+                t[4], t[5], t[6],
+                t[8], t[9], t[10],
+                rotators.re[i], rotators.x[i], rotators.y[i], rotators.z[i]);
+        }
+    }
+
+    template<typename T>
+    void Rotator3<T>::FromMatrix(const Execution& execution, const Matrix3x3<T>* matrices, QuaternionSoA<T> rotators)
+    {
+        Parallel::For(rotators.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            FromMatrix(matrices + begin, rotators.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    void Rotator3<T>::FromTransform(const Execution& execution, const Transform3dUniform<T>* transforms, QuaternionSoA<T> rotators)
+    {
+        Parallel::For(rotators.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            FromTransform(transforms + begin, rotators.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    void Rotator3<T>::FromToLane(
+        const T& from_x, const T& from_y, const T& from_z,
+        const T& to_x, const T& to_y, const T& to_z,
+        T& re, T& x, T& y, T& z) noexcept
+    {
+        const T lengths = std::sqrt((from_x * from_x + from_y * from_y + from_z * from_z) * (to_x * to_x + to_y * to_y + to_z * to_z));
+        const T dot = from_x * to_x + from_y * to_y + from_z * to_z;
+        T w = lengths + dot;
+        T cx = from_y * to_z - from_z * to_y;
+        T cy = from_z * to_x - from_x * to_z;
+        T cz = from_x * to_y - from_y * to_x;
+
+        // near opposite the cross product is noise, a half turn around any orthogonal axis is used instead
+        const bool opposite = w <= lengths * (16 * std::numeric_limits<T>::epsilon());
+        const bool x_major = std::abs(from_x) > std::abs(from_z);
+        const T ox = x_major ? -from_y : T(0);
+        const T oy = x_major ? from_x : -from_z;
+        const T oz = x_major ? T(0) : from_y;
+        w = opposite ? T(0) : w;
+        cx = opposite ? ox : cx;
+        cy = opposite ? oy : cy;
+        cz = opposite ? oz : cz;
+
+        const T length2 = w * w + cx * cx + cy * cy + cz * cz;
+        const bool valid = length2 > 0;
+        const T inv = T(1) / std::sqrt(valid ? length2 : T(1));
+        re = valid ? w * inv : T(1);
+        x = cx * inv;
+        y = cy * inv;
+        z = cz * inv;
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::FromTo(const Vector3<T>& from, const Vector3<T>& to) noexcept
+    {
+        Quaternion<T> result;
+        FromToLane(from.x, from.y, from.z, to.x, to.y, to.z, result.re, result.im.x, result.im.y, result.im.z);
+        return Rotator3<T>(result);
+    }
+
+    template<typename T>
+    void Rotator3<T>::FromTo(Vector3SoA<const T> from, Vector3SoA<const T> to, QuaternionSoA<T> rotators) noexcept
+    {
+        for(std::size_t i = 0; i < from.size; ++i)
+        {
+            FromToLane(from.x[i], from.y[i], from.z[i], to.x[i], to.y[i], to.z[i],
+                rotators.re[i], rotators.x[i], rotators.y[i], rotators.z[i]);
+        }
+    }
+
+    template<typename T>
+    void Rotator3<T>::FromTo(const Execution& execution, Vector3SoA<const T> from, Vector3SoA<const T> to, QuaternionSoA<T> rotators)
+    {
+        Parallel::For(from.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            FromTo(from.Slice(begin, end - begin), to.Slice(begin, end - begin), rotators.Slice(begin, end - begin));
+        }, execution);
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Rotator3<T>::FirstOrderLane(T& re, T& x, T& y, T& z, const T& wx, const T& wy, const T& wz, const T& half_dt,
+        MathT&& math_calculator) noexcept
+    {
+        // q += (-w.Dot(v), re * w + w.Cross(v)) * dt / 2
+        const T new_re = re - (wx * x + wy * y + wz * z) * half_dt;
+        const T new_x = x + (re * wx + (wy * z - wz * y)) * half_dt;
+        const T new_y = y + (re * wy + (wz * x - wx * z)) * half_dt;
+        const T new_z = z + (re * wz + (wx * y - wy * x)) * half_dt;
+
+        const T inv = math_calculator.RSqrt(new_re * new_re + new_x * new_x + new_y * new_y + new_z * new_z);
+        re = new_re * inv;
+        x = new_x * inv;
+        y = new_y * inv;
+        z = new_z * inv;
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Rotator3<T>::ExponentialLane(T& re, T& x, T& y, T& z, const T& wx, const T& wy, const T& wz, const T& half_dt,
+        MathT&& math_calculator) noexcept
+    {
+        // exp((0, w) * dt / 2) = (cos(angle), w * sin(angle) / |w|) with angle = |w| * dt / 2
+        const T angle2 = (wx * wx + wy * wy + wz * wz) * half_dt * half_dt;
+        const T angle = math_calculator.Sqrt(angle2);
+        // sin(angle) / angle by its series near zero, the error is below angle^6 / 5040
+        const bool small = angle2 < T(1e-4);
+        const T safe_angle = small ? T(1) : angle;
+        const T series = T(1) - angle2 * (T(1.0L / 6) - angle2 * T(1.0L / 120));
+        // both sides are computed, a call inside the select would become a branch
+        const T quotient = math_calculator.Sin(safe_angle) / safe_angle;
+        const T sinc = small ? series : quotient;
+        const T c = math_calculator.Cos(angle);
+        const T kx = wx * sinc * half_dt;
+        const T ky = wy * sinc * half_dt;
+        const T kz = wz * sinc * half_dt;
+
+        const T new_re = c * re - (kx * x + ky * y + kz * z);
+        const T new_x = c * x + re * kx + (ky * z - kz * y);
+        const T new_y = c * y + re * ky + (kz * x - kx * z);
+        const T new_z = c * z + re * kz + (kx * y - ky * x);
+
+        // the step itself is unit, this only removes the drift of the input
+        const T inv = math_calculator.RSqrt(new_re * new_re + new_x * new_x + new_y * new_y + new_z * new_z);
+        re = new_re * inv;
+        x = new_x * inv;
+        y = new_y * inv;
+        z = new_z * inv;
+    }
+
+    template<typename T>
+    Rotator3<T> Rotator3<T>::Integrated(const Vector3<T>& angular_velocity, const T& dt, Integration integration) const noexcept
+    {
+        return Integrated(angular_velocity, dt, integration, StdMath<T>());
+    }
+
+    template<typename T>
+    template<typename MathT>
+    Rotator3<T> Rotator3<T>::Integrated(const Vector3<T>& angular_velocity, const T& dt, Integration integration, MathT&& math_calculator) const noexcept
+    {
+        Quaternion<T> result = value;
+        if(integration == Integration::first_order)
+        {
+            FirstOrderLane(result.re, result.im.x, result.im.y, result.im.z, angular_velocity.x, angular_velocity.y, angular_velocity.z,
+                dt / 2, math_calculator);
+        }
+        else
+        {
+            ExponentialLane(result.re, result.im.x, result.im.y, result.im.z, angular_velocity.x, angular_velocity.y, angular_velocity.z,
+                dt / 2, math_calculator);
+        }
+        return Rotator3<T>(result);
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Rotator3<T>::Integrate(QuaternionSoA<T> rotators, Vector3SoA<const T> angular_velocities, const T& dt,
+        Integration integration, MathT&& math_calculator) noexcept
+    {
+        const T half_dt = dt / 2;
+        if(integration == Integration::first_order)
+        {
+            for(std::size_t i = 0; i < rotators.size; ++i)
+            {
+                FirstOrderLane(rotators.re[i], rotators.x[i], rotators.y[i], rotators.z[i],
+                    angular_velocities.x[i], angular_velocities.y[i], angular_velocities.z[i], half_dt, math_calculator);
+            }
+        }
+        else
+        {
+            for(std::size_t i = 0; i < rotators.size; ++i)
+            {
+                ExponentialLane(rotators.re[i], rotators.x[i], rotators.y[i], rotators.z[i],
+                    angular_velocities.x[i], angular_velocities.y[i], angular_velocities.z[i], half_dt, math_calculator);
+            }
+        }
+    }
+
+    template<typename T>
+    template<typename MathT>
+    void Rotator3<T>::Integrate(const Execution& execution, QuaternionSoA<T> rotators, Vector3SoA<const T> angular_velocities, const T& dt,
+        Integration integration, MathT&& math_calculator)
+    {
+        Parallel::For(rotators.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            Integrate(rotators.Slice(begin, end - begin), angular_velocities.Slice(begin, end - begin), dt, integration, math_calculator);
+        }, execution);
+    }
+}
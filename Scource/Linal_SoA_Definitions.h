@@ -0,0 +1,169 @@
+#pragma once
+#include "Linal.h"
+
+namespace linal
+{
+    template<typename T>
+    Vector2<std::remove_const_t<T>> Vector2SoA<T>::Get(std::size_t index) const noexcept
+    {
+        return { x[index], y[index] };
+    }
+
+    template<typename T>
+    void Vector2SoA<T>::Set(std::size_t index, const Vector2<std::remove_const_t<T>>& vector) const noexcept
+    {
+        x[index] = vector.x;
+        y[index] = vector.y;
+    }
+
+    template<typename T>
+    Vector2SoA<T> Vector2SoA<T>::Slice(std::size_t offset, std::size_t count) const noexcept
+    {
+        return { x + offset, y + offset, count };
+    }
+
+    template<typename T>
+    Vector2SoA<T>::operator Vector2SoA<const T>() const noexcept
+    {
+        return { x, y, size };
+    }
+
+    template<typename T>
+    Complex<std::remove_const_t<T>> ComplexSoA<T>::Get(std::size_t index) const noexcept
+    {
+        return { re[index], im[index] };
+    }
+
+    template<typename T>
+    void ComplexSoA<T>::Set(std::size_t index, const Complex<std::remove_const_t<T>>& complex) const noexcept
+    {
+        re[index] = complex.re;
+        im[index] = complex.im;
+    }
+
+    template<typename T>
+    ComplexSoA<T> ComplexSoA<T>::Slice(std::size_t offset, std::size_t count) const noexcept
+    {
+        return { re + offset, im + offset, count };
+    }
+
+    template<typename T>
+    ComplexSoA<T>::operator ComplexSoA<const T>() const noexcept
+    {
+        return { re, im, size };
+    }
+
+    template<typename T>
+    Matrix2x2<std::remove_const_t<T>> Matrix2x2SoA<T>::Get(std::size_t index) const noexcept
+    {
+        return { { xx[index], xy[index] }, { yx[index], yy[index] } };
+    }
+
+    template<typename T>
+    void Matrix2x2SoA<T>::Set(std::size_t index, const Matrix2x2<std::remove_const_t<T>>& matrix) const noexcept
+    {
+        xx[index] = matrix.line0.x;
+        xy[index] = matrix.line0.y;
+        yx[index] = matrix.line1.x;
+        yy[index] = matrix.line1.y;
+    }
+
+    template<typename T>
+    Matrix2x2SoA<T> Matrix2x2SoA<T>::Slice(std::size_t offset, std::size_t count) const noexcept
+    {
+        return { xx + offset, xy + offset, yx + offset, yy + offset, count };
+    }
+
+    template<typename T>
+    Matrix2x2SoA<T>::operator Matrix2x2SoA<const T>() const noexcept
+    {
+        return { xx, xy, yx, yy, size };
+    }
+
+    template<typename T>
+    Vector3<std::remove_const_t<T>> Vector3SoA<T>::Get(std::size_t index) const noexcept
+    {
+        return { x[index], y[index], z[index] };
+    }
+
+    template<typename T>
+    void Vector3SoA<T>::Set(std::size_t index, const Vector3<std::remove_const_t<T>>& vector) const noexcept
+    {
+        x[index] = vector.x;
+        y[index] = vector.y;
+        z[index] = vector.z;
+    }
+
+    template<typename T>
+    Vector3SoA<T> Vector3SoA<T>::Slice(std::size_t offset, std::size_t count) const noexcept
+    {
+        return { x + offset, y + offset, z + offset, count };
+    }
+
+    template<typename T>
+    Vector3SoA<T>::operator Vector3SoA<const T>() const noexcept
+    {
+        return { x, y, z, size };
+    }
+
+    template<typename T>
+    Quaternion<std::remove_const_t<T>> QuaternionSoA<T>::Get(std::size_t index) const noexcept
+    {
+        return { re[index], { x[index], y[index], z[index] } };
+    }
+
+    template<typename T>
+    void QuaternionSoA<T>::Set(std::size_t index, const Quaternion<std::remove_const_t<T>>& quaternion) const noexcept
+    {
+        re[index] = quaternion.re;
+        x[index] = quaternion.im.x;
+        y[index] = quaternion.im.y;
+        z[index] = quaternion.im.z;
+    }
+
+    template<typename T>
+    QuaternionSoA<T> QuaternionSoA<T>::Slice(std::size_t offset, std::size_t count) const noexcept
+    {
+        return { re + offset, x + offset, y + offset, z + offset, count };
+    }
+
+    template<typename T>
+    QuaternionSoA<T>::operator QuaternionSoA<const T>() const noexcept
+    {
+        return { re, x, y, z, size };
+    }
+
+    template<typename T>
+    Matrix3x3<std::remove_const_t<T>> Symmetric3SoA<T>::Get(std::size_t index) const noexcept
+    {
+        return
+        {
+            { xx[index], xy[index], xz[index] },
+            { xy[index], yy[index], yz[index] },
+            { xz[index], yz[index], zz[index] }
+        };
+    }
+
+    template<typename T>
+    void Symmetric3SoA<T>::Set(std::size_t index, const Matrix3x3<std::remove_const_t<T>>& matrix) const noexcept
+    {
+        xx[index] = matrix.line0.x;
+        xy[index] = matrix.line0.y;
+        xz[index] = matrix.line0.z;
+        yy[index] = matrix.line1.y;
+        yz[index] = matrix.line1.z;
+        zz[index] = matrix.line2.z;
+    }
+
+    template<typename T>
+    Symmetric3SoA<T> Symmetric3SoA<T>::Slice(std::size_t offset, std::size_t count) const noexcept
+    {
+        return { xx + offset, xy + offset, xz + offset, yy + offset, yz + offset, zz + offset, count };
+    }
+
+    template<typename T>
+    Symmetric3SoA<T>::operator Symmetric3SoA<const T>() const noexcept
+    {
+        return { xx, xy, xz, yy, yz, zz, size };
+    }
+} // namespace linal
@@ -26,8 +26,8 @@ namespace linal
     Vector3<T>& Vector3<T>::operator*=(const T& scalar) noexcept
     {
         x *= scalar;
-        x *= scalar;
-        x *= scalar;
+        y *= scalar;
+        z *= scalar;
         return *this;
     }
 
@@ -35,8 +35,8 @@ namespace linal
     Vector3<T>& Vector3<T>::operator/=(const T& scalar)
     {
         x /= scalar;
-        x /= scalar;
-        x /= scalar;
+        y /= scalar;
+        z /= scalar;
         return *this;
     }
 
@@ -93,7 +93,7 @@ namespace linal
     template<typename T>
     Vector3<T> Vector3<T>::operator*(const Matrix3x3<T>& matrix) const noexcept
     {
-        return Vector3<T>{Dot(matrix.line0), Dot(matrix.line0), Dot(matrix.line1)};
+        return matrix.line0 * x + matrix.line1 * y + matrix.line2 * z;
     }
 
     template<typename T>
@@ -113,7 +113,7 @@ namespace linal
                 y * other.z - z * other.y,
                 z * other.x - x * other.z,
                 x * other.y - y * other.x,
-            }
+            };
     }
 
     template<typename T>
@@ -0,0 +1,209 @@
+#pragma once
+#include "Linal.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace linal
+{
+    template<typename T>
+    std::vector<std::uint32_t> Weld3<T>::Remap(Vector3SoA<const T> points, const T& epsilon2, const Execution& execution)
+    {
+        if(points.size > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error("too many points for weld");
+        }
+        std::vector<std::uint32_t> remap(points.size);
+        if(!(epsilon2 > T(0)))
+        {
+            for(std::size_t i = 0; i < points.size; ++i)
+            {
+                remap[i] = static_cast<std::uint32_t>(i);
+            }
+            return remap;
+        }
+
+        // the limit keeps the rounding of the cell coordinates far below a cell and the neighbors inside int
+        T inverse = T(1) / (T(4) * std::sqrt(epsilon2));
+        T limit = std::min(T(1 << 30), T(0.125) / std::numeric_limits<T>::epsilon());
+        std::vector<Vector3I> point_cells(points.size);
+        Parallel::For(points.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                point_cells[i] = Cell(points.x[i], points.y[i], points.z[i], inverse, limit);
+            }
+        }, execution);
+
+        Grid grid;
+        std::size_t capacity = 16;
+        while(capacity < 2 * points.size)
+        {
+            capacity *= 2;
+        }
+        grid.table.resize(capacity);
+        grid.point_cells.resize(points.size);
+        std::uint32_t cell_count = 0;
+        for(std::size_t i = 0; i < points.size; ++i)
+        {
+            const Vector3I& cell = point_cells[i];
+            if(cell.x == INT_MIN || cell.y == INT_MIN || cell.z == INT_MIN)
+            {
+                throw std::runtime_error("coordinate out of range for the weld epsilon");
+            }
+            typename Grid::Entry& entry = grid.table[grid.Slot(cell)];
+            if(entry.id == 0)
+            {
+                entry.cell = cell;
+                entry.id = ++cell_count;
+                grid.cells.push_back(cell);
+            }
+            grid.point_cells[i] = entry.id - 1;
+        }
+
+        grid.offsets.assign(std::size_t(cell_count) + 1, 0);
+        for(std::size_t i = 0; i < points.size; ++i)
+        {
+            ++grid.offsets[grid.point_cells[i] + 1];
+        }
+        for(std::size_t c = 0; c < cell_count; ++c)
+        {
+            grid.offsets[c + 1] += grid.offsets[c];
+        }
+        grid.members.resize(points.size);
+        std::vector<std::uint32_t> fill(grid.offsets.begin(), grid.offsets.end() - 1);
+        for(std::size_t i = 0; i < points.size; ++i)
+        {
+            grid.members[fill[grid.point_cells[i]]++] = static_cast<std::uint32_t>(i);
+        }
+
+        // the first equal point before every point, found in parallel
+        Parallel::For(points.size, Parallel::batch_grain, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                remap[i] = First(grid, points, epsilon2, inverse, static_cast<std::uint32_t>(i), [](std::uint32_t) { return true; });
+            }
+        }, execution);
+
+        // in order, a first equal point that was merged itself is not kept, so the point searches again among the kept ones.
+        // Compare is not transitive, this only happens for chains of points around the epsilon
+        for(std::size_t i = 0; i < points.size; ++i)
+        {
+            std::uint32_t j = remap[i];
+            if(j != i && remap[j] != j)
+            {
+                remap[i] = First(grid, points, epsilon2, inverse, static_cast<std::uint32_t>(i), [&](std::uint32_t k) { return remap[k] == k; });
+            }
+        }
+        return remap;
+    }
+
+    template<typename T>
+    std::vector<std::uint32_t> Weld3<T>::Compact(std::vector<std::uint32_t>& remap)
+    {
+        // merged points refer to an earlier kept point, whose entry already is its new index
+        std::vector<std::uint32_t> kept;
+        for(std::size_t i = 0; i < remap.size(); ++i)
+        {
+            if(remap[i] == i)
+            {
+                remap[i] = static_cast<std::uint32_t>(kept.size());
+                kept.push_back(static_cast<std::uint32_t>(i));
+            }
+            else
+            {
+                remap[i] = remap[remap[i]];
+            }
+        }
+        return kept;
+    }
+
+    template<typename T>
+    std::size_t Weld3<T>::Grid::Slot(const Vector3I& cell) const noexcept
+    {
+        std::uint64_t hash =
+            std::uint64_t(std::uint32_t(cell.x)) * 0x9E3779B97F4A7C15 ^
+            std::uint64_t(std::uint32_t(cell.y)) * 0xC2B2AE3D27D4EB4F ^
+            std::uint64_t(std::uint32_t(cell.z)) * 0x165667B19E3779F9;
+        hash ^= hash >> 32;
+
+        std::size_t mask = table.size() - 1;
+        for(std::size_t slot = std::size_t(hash) & mask;; slot = (slot + 1) & mask)
+        {
+            if(table[slot].id == 0 || table[slot].cell == cell)
+            {
+                return slot;
+            }
+        }
+    }
+
+    template<typename T>
+    Vector3I Weld3<T>::Cell(const T& x, const T& y, const T& z, const T& inverse, const T& limit) noexcept
+    {
+        auto component = [&](const T& value)
+        {
+            // cells are centered on the multiples of their size, where rounded input coordinates tend to be
+            T cell = std::floor(value * inverse + T(0.5));
+            bool valid = cell >= -limit && cell <= limit;
+            int index = static_cast<int>(valid ? cell : T(0));
+            return valid ? index : INT_MIN;
+        };
+        return { component(x), component(y), component(z) };
+    }
+
+    template<typename T>
+    template<typename AcceptT>
+    std::uint32_t Weld3<T>::First(const Grid& grid, Vector3SoA<const T> points, const T& epsilon2, const T& inverse, std::uint32_t i,
+        AcceptT&& accept) noexcept
+    {
+        // an equal point is less than a quarter cell away, plus the rounding of both cell coordinates.
+        // the neighbor on a side is searched only if the point is that close to it
+        Vector3<T> point = points.Get(i);
+        const Vector3I& own = grid.cells[grid.point_cells[i]];
+        const T coordinates[3] = { point.x, point.y, point.z };
+        const int cell[3] = { own.x, own.y, own.z };
+        int lower[3];
+        int upper[3];
+        for(std::size_t axis = 0; axis < 3; ++axis)
+        {
+            T scaled = coordinates[axis] * inverse + T(0.5);
+            T fraction = scaled - T(cell[axis]);
+            T slack = T(0.25) + (std::abs(scaled) + T(1)) * T(4) * std::numeric_limits<T>::epsilon();
+            lower[axis] = fraction < slack ? -1 : 0;
+            upper[axis] = fraction > T(1) - slack ? 1 : 0;
+        }
+
+        std::uint32_t first = i;
+        for(int dx = lower[0]; dx <= upper[0]; ++dx)
+        {
+            for(int dy = lower[1]; dy <= upper[1]; ++dy)
+            {
+                for(int dz = lower[2]; dz <= upper[2]; ++dz)
+                {
+                    // the own cell is known without a lookup
+                    std::uint32_t id = grid.point_cells[i] + 1;
+                    if(dx != 0 || dy != 0 || dz != 0)
+                    {
+                        id = grid.table[grid.Slot({ cell[0] + dx, cell[1] + dy, cell[2] + dz })].id;
+                    }
+                    if(id == 0)
+                    {
+                        continue;
+                    }
+                    // members are ascending, so only the ones before the best so far are tested
+                    for(std::uint32_t k = grid.offsets[id - 1]; k < grid.offsets[id] && grid.members[k] < first; ++k)
+                    {
+                        std::uint32_t j = grid.members[k];
+                        if(accept(j) && points.Get(j).Compare(point, epsilon2))
+                        {
+                            first = j;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        return first;
+    }
+} // namespace linal
@@ -1,11 +1,66 @@
 #include "Linal.h"
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <new>
 
 using namespace std;
+
+// upstream whose blocks are simd aligned but never more, the arena must not rely on upstream over-aligning
+struct ShiftedResource : std::pmr::memory_resource
+{
+    bool mismatch = false;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        unsigned char* block = static_cast<unsigned char*>(::operator new(bytes + 2 * linal::simd_alignment, std::align_val_t{2 * linal::simd_alignment}));
+        std::memcpy(block, &alignment, sizeof(alignment));
+        return block + linal::simd_alignment;
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        unsigned char* block = static_cast<unsigned char*>(pointer) - linal::simd_alignment;
+        std::size_t allocated;
+        std::memcpy(&allocated, block, sizeof(allocated));
+        mismatch = mismatch || allocated != alignment;
+        ::operator delete(block, bytes + 2 * linal::simd_alignment, std::align_val_t{2 * linal::simd_alignment});
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// over-aligned blocks from the frame arena, from the current chunk and from new ones
+static bool CheckFrameArenaAlignment()
+{
+    ShiftedResource upstream;
+    bool aligned = true;
+    {
+        linal::FrameArena arena(4096, &upstream);
+        const std::size_t requests[][2] = { { 16, 128 }, { 16, 256 }, { 5000, 256 }, { 24, 4096 }, { 16, 128 }, { 8192, 4096 } };
+        for(const auto& request : requests)
+        {
+            void* pointer = arena.allocate(request[0], request[1]);
+            std::memset(pointer, 0, request[0]);
+            aligned = aligned && reinterpret_cast<std::uintptr_t>(pointer) % request[1] == 0;
+        }
+        arena.Release();
+    }
+    return aligned && !upstream.mismatch;
+}
+
 int main()
 {
-    
+    if(!CheckFrameArenaAlignment())
+    {
+        cout << "frame arena returned a misaligned block" << endl;
+        return 1;
+    }
 
     return 0;
-}
\ No newline at end of file
+}